@@ -0,0 +1,41 @@
+// Compares running the action of an argument with many values, for the
+// built-in action of store_into(), a lambda stored in place and a lambda
+// wrapped in a std::function.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_values = 5000;
+
+int main() {
+  std::vector<int> stored;
+  int sum = 0;
+  argparse::ArgumentParser program("actions", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_argument("--store")
+      .nargs(argparse::nargs_pattern::any)
+      .store_into(stored);
+  program.add_argument("--lambda")
+      .nargs(argparse::nargs_pattern::any)
+      .action([&sum](const std::string &value) { sum += std::stoi(value); });
+  program.add_argument("--function")
+      .nargs(argparse::nargs_pattern::any)
+      .action(std::function<void(const std::string &)>(
+          [&sum](const std::string &value) { sum += std::stoi(value); }));
+
+  for (const auto *name : {"--store", "--lambda", "--function"}) {
+    std::vector<std::string> command_line{"actions", name};
+    for (std::size_t i = 0; i < number_of_values; ++i) {
+      command_line.push_back(std::to_string(i));
+    }
+    benchmark::report(std::string(name) + " parse per value",
+                      benchmark::measure(number_of_values, [&] {
+                        auto result = program.parse(command_line);
+                        benchmark::do_not_optimize(result);
+                      }));
+  }
+  benchmark::do_not_optimize(sum);
+}
@@ -0,0 +1,73 @@
+#ifndef ARGPARSE_BENCHMARK_ALLOCATION_COUNTER_HPP
+#define ARGPARSE_BENCHMARK_ALLOCATION_COUNTER_HPP
+
+// Replaces the global operator new to count heap allocations. Include it in
+// the one translation unit of a benchmark that reports allocations.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// The replacements below are visible to GCC, which then pairs inlined
+// allocations with std::free and wrongly reports a mismatch
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace benchmark {
+inline std::size_t allocations = 0;
+} // namespace benchmark
+
+void *operator new(std::size_t size) {
+  ++benchmark::allocations;
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  ++benchmark::allocations;
+  const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+  void *p = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+  void *p = std::aligned_alloc(align, (size + align) / align * align);
+#endif
+  if (p != nullptr) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t /*unused*/) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t /*unused*/) noexcept {
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+void operator delete(void *p, std::size_t /*unused*/,
+                     std::align_val_t alignment) noexcept {
+  operator delete(p, alignment);
+}
+
+namespace benchmark {
+
+// The number of heap allocations made by f
+template <typename F> std::size_t count_allocations(F &&f) {
+  const auto before = allocations;
+  f();
+  return allocations - before;
+}
+
+} // namespace benchmark
+
+#endif // ARGPARSE_BENCHMARK_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,59 @@
+// Compares the cost of looking up arguments by name in a parser with many
+// options, before (std::map) and after freeze() (flat index).
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_options = 900;
+
+static void add_options(argparse::ArgumentParser &program,
+                        std::vector<std::string> &names) {
+  for (std::size_t i = 0; i < number_of_options; ++i) {
+    names.push_back("--option-" + std::to_string(i));
+    program.add_argument(names.back()).flag();
+  }
+}
+
+static void run(std::string_view label, argparse::ArgumentParser &program,
+                const std::vector<std::string> &names,
+                const std::vector<std::string> &command_line) {
+
+  benchmark::report(std::string(label) + " operator[] by full name",
+                    benchmark::measure(names.size(), [&] {
+                      for (const auto &name : names) {
+                        benchmark::do_not_optimize(program[name]);
+                      }
+                    }));
+
+  benchmark::report(std::string(label) + " operator[] without prefix",
+                    benchmark::measure(names.size(), [&] {
+                      for (const auto &name : names) {
+                        benchmark::do_not_optimize(
+                            program[std::string_view(name).substr(2)]);
+                      }
+                    }));
+
+  benchmark::report(std::string(label) + " parse per token",
+                    benchmark::measure(command_line.size(), [&] {
+                      auto result = program.parse(command_line);
+                      benchmark::do_not_optimize(result);
+                    }));
+}
+
+int main() {
+  argparse::ArgumentParser program("lookup", "1.0",
+                                   argparse::default_arguments::none);
+  std::vector<std::string> names;
+  add_options(program, names);
+
+  std::vector<std::string> command_line{"lookup"};
+  for (std::size_t i = 0; i < names.size(); i += 3) {
+    command_line.push_back(names[i]);
+  }
+
+  run("std::map", program, names, command_line);
+  program.freeze();
+  run("flat index", program, names, command_line);
+}
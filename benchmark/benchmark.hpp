@@ -0,0 +1,48 @@
+#ifndef ARGPARSE_BENCHMARK_HPP
+#define ARGPARSE_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+namespace benchmark {
+
+// Keep the compiler from optimizing away a computed value
+template <typename T> void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r"(&value) : "memory");
+#else
+  static const volatile void *volatile sink;
+  sink = &value;
+#endif
+}
+
+// Call f (which performs `operations` operations per call) repeatedly for
+// about 200ms and return the mean time per operation in nanoseconds.
+template <typename F> double measure(std::size_t operations, F &&f) {
+  using clock = std::chrono::steady_clock;
+  const auto budget = std::chrono::milliseconds(200);
+  std::size_t calls = 0;
+  const auto start = clock::now();
+  auto elapsed = clock::duration{};
+  do {
+    f();
+    ++calls;
+    elapsed = clock::now() - start;
+  } while (elapsed < budget);
+  const auto ns =
+      std::chrono::duration<double, std::nano>(elapsed).count();
+  return ns / static_cast<double>(calls * operations);
+}
+
+inline void report(std::string_view name, double ns_per_op) {
+  std::cout << std::left << std::setw(48) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << ns_per_op << " ns/op\n";
+}
+
+} // namespace benchmark
+
+#endif // ARGPARSE_BENCHMARK_HPP
@@ -0,0 +1,83 @@
+// Measures the size of the programs under samples/, built with the compiler
+// of the build at -Os and stripped, in bytes. The size of an ELF program is
+// that of its loaded segments, since its file is padded to whole pages.
+#include <compiler.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// The sum of the p_filesz of the PT_LOAD segments of a 64-bit little-endian
+// ELF file, or the size of any other file
+static std::uintmax_t loaded_size(const fs::path &program) {
+  std::ifstream file(program, std::ios::binary);
+  const std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+  const auto read = [&](std::size_t offset, std::size_t size) {
+    std::uint64_t value = 0;
+    for (std::size_t i = size; i-- > 0;) {
+      value = (value << 8) | static_cast<unsigned char>(bytes[offset + i]);
+    }
+    return static_cast<std::size_t>(value);
+  };
+  if (bytes.size() < 64 || std::memcmp(bytes.data(), "\x7f" "ELF", 4) != 0 ||
+      bytes[4] != 2 || bytes[5] != 1) {
+    return bytes.size();
+  }
+  const auto phoff = read(32, 8);
+  const auto phentsize = read(54, 2);
+  const auto phnum = read(56, 2);
+  std::uintmax_t size = 0;
+  for (std::size_t i = 0; i < phnum; ++i) {
+    const auto header = phoff + i * phentsize;
+    if (header + 40 <= bytes.size() && read(header, 4) == 1) {
+      size += read(header + 32, 8);
+    }
+  }
+  return size;
+}
+
+static std::uintmax_t binary_size(const fs::path &source) {
+  const auto program =
+      fs::temp_directory_path() / ("argparse_" + source.stem().string());
+  if (!benchmark::compile("-Os -s", source.string(), program.string())) {
+    std::cerr << "failed to compile " << source << '\n';
+    std::exit(1);
+  }
+  const auto size = loaded_size(program);
+  fs::remove(program);
+  return size;
+}
+
+int main() {
+  std::vector<fs::path> samples;
+  for (const auto &entry :
+       fs::directory_iterator(ARGPARSE_BENCHMARK_SAMPLES_DIR)) {
+    if (entry.path().extension() == ".cpp") {
+      samples.push_back(entry.path());
+    }
+  }
+  std::sort(samples.begin(), samples.end());
+
+  std::cout << std::left << std::setw(40) << "sample" << std::right
+            << std::setw(12) << "size" << '\n';
+  std::uintmax_t total = 0;
+  for (const auto &sample : samples) {
+    const auto size = binary_size(sample);
+    total += size;
+    std::cout << std::left << std::setw(40) << sample.stem().string()
+              << std::right << std::setw(12) << size << '\n';
+  }
+  std::cout << std::left << std::setw(40) << "total" << std::right
+            << std::setw(12) << total << '\n';
+}
@@ -0,0 +1,69 @@
+// Compares converting a long list of decimal integers with scan<'d', int>()
+// and store_into(std::vector<int> &), which convert runs of plain decimal
+// values at once, to converting each value in an action.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr std::size_t number_of_values = 1000000;
+
+int main() {
+  std::vector<int> ids;
+  argparse::ArgumentParser program("ids", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_argument("--scan")
+      .nargs(argparse::nargs_pattern::any)
+      .scan<'d', int>();
+  program.add_argument("--store")
+      .nargs(argparse::nargs_pattern::any)
+      .store_into(ids);
+  program.add_argument("--action")
+      .nargs(argparse::nargs_pattern::any)
+      .action([](const std::string &value) {
+        return argparse::details::parse_number<int, argparse::details::radix_10>()(
+            value);
+      });
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> distribution(0, 999999999);
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    values.push_back(std::to_string(distribution(random)));
+  }
+
+  const std::vector<std::string_view> views(values.begin(), values.end());
+  std::vector<int> converted;
+  benchmark::report("parse_number per value",
+                    benchmark::measure(number_of_values, [&] {
+                      converted.clear();
+                      for (const auto value : views) {
+                        converted.push_back(
+                            argparse::details::parse_number<
+                                int, argparse::details::radix_10>()(value));
+                      }
+                      benchmark::do_not_optimize(converted);
+                    }));
+  benchmark::report("parse_decimal_run per value",
+                    benchmark::measure(number_of_values, [&] {
+                      converted.clear();
+                      argparse::details::parse_decimal_run(
+                          views.data(), views.data() + views.size(),
+                          converted);
+                      benchmark::do_not_optimize(converted);
+                    }));
+
+  for (const auto *name : {"--scan", "--store", "--action"}) {
+    std::vector<std::string> command_line{"ids", name};
+    command_line.insert(command_line.end(), values.begin(), values.end());
+    benchmark::report(std::string(name) + " parse per value",
+                      benchmark::measure(number_of_values, [&] {
+                        auto result = program.parse(command_line);
+                        benchmark::do_not_optimize(result);
+                      }));
+  }
+  benchmark::do_not_optimize(ids);
+}
@@ -0,0 +1,45 @@
+// Measures checking values against an argument with many allowed choices,
+// e.g. tenant IDs, and building the message for a rejected value.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_choices = 20000;
+constexpr std::size_t number_of_values = 100;
+
+int main() {
+  argparse::ArgumentParser program("test", "1.0",
+                                   argparse::default_arguments::none);
+  auto &tenant = program.add_argument("--tenant")
+                     .nargs(argparse::nargs_pattern::any)
+                     .default_value(std::string("tenant-0"));
+  for (std::size_t i = 0; i < number_of_choices; ++i) {
+    tenant.add_choice("tenant-" + std::to_string(i));
+  }
+  tenant.choices("admin");
+  program.freeze();
+
+  std::vector<std::string> command_line{"test", "--tenant"};
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    command_line.push_back("tenant-" + std::to_string(i * 197));
+  }
+  benchmark::report("parse per value",
+                    benchmark::measure(number_of_values, [&] {
+                      auto result = program.parse(command_line);
+                      benchmark::do_not_optimize(result);
+                    }));
+
+  const std::vector<std::string> invalid{"test", "--tenant", "tenant-x"};
+  benchmark::report("parse with an invalid value",
+                    benchmark::measure(1, [&] {
+                      try {
+                        auto result = program.parse(invalid);
+                        benchmark::do_not_optimize(result);
+                      } catch (const std::runtime_error &e) {
+                        benchmark::do_not_optimize(e);
+                      }
+                    }));
+}
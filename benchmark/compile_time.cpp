@@ -0,0 +1,47 @@
+// Measures the time to compile a translation unit using argparse in the
+// header-only mode and against the compiled argparse_lib library, by running
+// the compiler of the build on compile_time_unit.cpp, in ms per translation
+// unit (the best of a few runs).
+#include <compiler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+static double compile_ms(const std::string &flags) {
+  const auto object = std::filesystem::temp_directory_path() /
+                      "argparse_compile_time_unit.o";
+  double best = 0;
+  for (int run = 0; run < 3; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!benchmark::compile(flags + " -c", ARGPARSE_BENCHMARK_UNIT,
+                            object.string())) {
+      std::cerr << "failed to compile " << ARGPARSE_BENCHMARK_UNIT << '\n';
+      std::exit(1);
+    }
+    const auto ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    best = run == 0 ? ms : std::min(best, ms);
+  }
+  std::filesystem::remove(object);
+  return best;
+}
+
+static void report(std::string_view name, double ms) {
+  std::cout << std::left << std::setw(48) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1) << ms
+            << " ms/TU\n";
+}
+
+int main() {
+  report("header-only, -O0", compile_ms("-O0"));
+  report("argparse_lib, -O0", compile_ms("-O0 -DARGPARSE_COMPILED_LIB"));
+  report("header-only, -O2", compile_ms("-O2"));
+  report("argparse_lib, -O2", compile_ms("-O2 -DARGPARSE_COMPILED_LIB"));
+}
@@ -0,0 +1,30 @@
+// A translation unit using argparse the way a typical tool does, which the
+// compile_time benchmark compiles with and without ARGPARSE_COMPILED_LIB.
+#include <argparse/argparse.hpp>
+
+#include <string>
+#include <vector>
+
+int run(int argc, char *argv[]) {
+  argparse::ArgumentParser program("tool", "1.0");
+  program.add_argument("-o", "--output").default_value(std::string("a.out"));
+  program.add_argument("-j", "--jobs").scan<'i', int>().default_value(1);
+  program.add_argument("--ratio").scan<'g', double>();
+  program.add_argument("--verbose").flag();
+  program.add_argument("inputs").nargs(argparse::nargs_pattern::at_least_one);
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << '\n' << program;
+    return 1;
+  }
+
+  const auto output = program.get<std::string>("--output");
+  const auto jobs = program.get<int>("--jobs");
+  const auto ratio = program.present<double>("--ratio");
+  const auto inputs = program.get<std::vector<std::string>>("inputs");
+  const auto verbose = program.get<bool>("--verbose");
+  return static_cast<int>(output.size() + inputs.size()) + jobs +
+         static_cast<int>(ratio.value_or(0.0)) + (verbose ? 1 : 0);
+}
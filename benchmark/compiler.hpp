@@ -0,0 +1,25 @@
+#ifndef ARGPARSE_BENCHMARK_COMPILER_HPP
+#define ARGPARSE_BENCHMARK_COMPILER_HPP
+
+#include <cstdlib>
+#include <string>
+
+namespace benchmark {
+
+/* Compiles source with the compiler of the build, given as
+ * ARGPARSE_BENCHMARK_CXX, which takes GCC-style options, and the include
+ * directory of argparse.
+ * @returns false if the compiler fails
+ */
+inline bool compile(const std::string &flags, const std::string &source,
+                    const std::string &output) {
+  const std::string command = std::string("\"") + ARGPARSE_BENCHMARK_CXX +
+                              "\" -std=c++17 " + flags + " -I\"" +
+                              ARGPARSE_BENCHMARK_INCLUDE_DIR + "\" \"" +
+                              source + "\" -o \"" + output + "\"";
+  return std::system(command.c_str()) == 0;
+}
+
+} // namespace benchmark
+
+#endif // ARGPARSE_BENCHMARK_COMPILER_HPP
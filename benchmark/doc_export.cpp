@@ -0,0 +1,45 @@
+// Measures exporting the documentation of a tree of 2000 subcommands.
+#include <argparse/doc_export.hpp>
+#include <benchmark.hpp>
+
+#include <list>
+#include <string>
+
+constexpr std::size_t number_of_subcommands = 2000;
+constexpr std::size_t number_of_options = 20;
+
+int main() {
+  argparse::ArgumentParser program("tool");
+  std::list<argparse::ArgumentParser> commands;
+  for (std::size_t i = 0; i < number_of_subcommands; ++i) {
+    auto &command = commands.emplace_back("command-" + std::to_string(i));
+    command.add_description("Runs command number " + std::to_string(i));
+    for (std::size_t j = 0; j < number_of_options; ++j) {
+      command.add_argument("--option-" + std::to_string(j))
+          .help("sets option " + std::to_string(j))
+          .default_value(std::to_string(j));
+    }
+    command.add_argument("input").help("the file to read");
+    program.add_subparser(command);
+  }
+
+  for (const auto format : {argparse::doc_format::man,
+                            argparse::doc_format::markdown,
+                            argparse::doc_format::json}) {
+    const char *name = format == argparse::doc_format::man ? "man"
+                       : format == argparse::doc_format::markdown
+                           ? "markdown"
+                           : "json";
+    for (const std::size_t threads : {1, 0}) {
+      argparse::DocOptions options;
+      options.format = format;
+      options.threads = threads;
+      benchmark::report(std::string(name) + (threads == 1 ? ", 1 thread"
+                                                          : ", all cores"),
+                        benchmark::measure(1, [&] {
+                          auto docs = argparse::export_docs(program, options);
+                          benchmark::do_not_optimize(docs);
+                        }));
+    }
+  }
+}
@@ -0,0 +1,42 @@
+// Compares rejecting an invalid command line with parse(), which throws
+// an exception with its message, to try_parse(), which returns an error
+// code and only builds the message when asked for.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").scan<'i', int>();
+  program.add_argument("--mode").choices("fast", "slow");
+  program.add_argument("--name").required();
+  program.add_argument("input");
+  program.freeze();
+
+  const std::vector<std::vector<std::string>> command_lines{
+      {"test", "--name", "x", "in", "--count", "12a"},
+      {"test", "--name", "x", "in", "--mode", "medium"},
+      {"test", "--name", "x", "in", "--bogus"},
+      {"test", "in"}};
+
+  for (const auto &command_line : command_lines) {
+    const auto label = command_line.back();
+    benchmark::report("parse throws, " + label,
+                      benchmark::measure(1, [&] {
+                        try {
+                          auto result = program.parse(command_line);
+                          benchmark::do_not_optimize(result);
+                        } catch (const std::exception &e) {
+                          benchmark::do_not_optimize(e);
+                        }
+                      }));
+    benchmark::report("try_parse, " + label,
+                      benchmark::measure(1, [&] {
+                        auto result = program.try_parse(command_line);
+                        benchmark::do_not_optimize(result);
+                      }));
+  }
+}
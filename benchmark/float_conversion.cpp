@@ -0,0 +1,59 @@
+// Compares reading floating point numbers with std::from_chars, as
+// parse_number does when it is available, to the strtod path, which needs a
+// std::string for each value.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr std::size_t number_of_values = 10000;
+
+template <typename T>
+void compare(std::string_view type, const std::vector<std::string> &values) {
+  const std::vector<std::string_view> views(values.begin(), values.end());
+  std::vector<T> converted;
+  converted.reserve(values.size());
+
+  benchmark::report(std::string(type) + " strtod per value",
+                    benchmark::measure(number_of_values, [&] {
+                      converted.clear();
+                      for (const auto value : views) {
+                        converted.push_back(argparse::details::do_strtod<T>(
+                            std::string(value)));
+                      }
+                      benchmark::do_not_optimize(converted);
+                    }));
+  benchmark::report(
+      std::string(type) + " parse_number per value",
+      benchmark::measure(number_of_values, [&] {
+        converted.clear();
+        for (const auto value : views) {
+          converted.push_back(
+              argparse::details::parse_number<
+                  T, argparse::details::chars_format::general>()(value));
+        }
+        benchmark::do_not_optimize(converted);
+      }));
+}
+
+int main() {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent(-30, 30);
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    std::ostringstream value;
+    value.precision(i % 17 + 1);
+    value << mantissa(random) * std::pow(10.0, exponent(random));
+    values.push_back(value.str());
+  }
+
+  compare<float>("float", values);
+  compare<double>("double", values);
+  compare<long double>("long double", values);
+}
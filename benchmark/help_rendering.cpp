@@ -0,0 +1,71 @@
+// Measures rendering the help of every node of a tree of subcommands, as a
+// generator of documentation does, and of a parser with many groups.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <list>
+#include <string>
+
+constexpr std::size_t number_of_subcommands = 2000;
+constexpr std::size_t number_of_options = 10;
+constexpr std::size_t number_of_groups = 100;
+constexpr std::size_t number_of_mutexes_per_group = 5;
+
+int main() {
+  argparse::ArgumentParser program("tool");
+  std::list<argparse::ArgumentParser> commands;
+  for (std::size_t i = 0; i < number_of_subcommands; ++i) {
+    auto &command = commands.emplace_back("command-" + std::to_string(i));
+    command.add_description("Runs command number " + std::to_string(i));
+    for (std::size_t j = 0; j < number_of_options; ++j) {
+      command.add_argument("--option-" + std::to_string(j))
+          .help("sets option " + std::to_string(j))
+          .default_value(std::to_string(j));
+    }
+    command.add_argument("input").help("the file to read");
+    program.add_subparser(command);
+  }
+
+  const auto render_tree = [&] {
+    std::size_t size = program.help_text()->size();
+    for (const auto &command : commands) {
+      size += command.help_text()->size();
+    }
+    benchmark::do_not_optimize(size);
+  };
+
+  benchmark::report("help of the tree, rendered",
+                    benchmark::measure(1, [&] {
+                      // Changing the description drops the rendered help
+                      program.add_description("A tool");
+                      for (auto &command : commands) {
+                        command.add_description("A command");
+                      }
+                      render_tree();
+                    }));
+  benchmark::report("help of the tree, cached",
+                    benchmark::measure(1, render_tree));
+  benchmark::report("operator<< of the root", benchmark::measure(1, [&] {
+                      std::string text = program.help().str();
+                      benchmark::do_not_optimize(text);
+                    }));
+
+  argparse::ArgumentParser grouped("grouped");
+  grouped.set_usage_max_line_width(100);
+  for (std::size_t i = 0; i < number_of_groups; ++i) {
+    grouped.add_group("Group " + std::to_string(i));
+    for (std::size_t j = 0; j < number_of_mutexes_per_group; ++j) {
+      auto &mutex = grouped.add_mutually_exclusive_group();
+      for (std::size_t k = 0; k < 2; ++k) {
+        mutex
+            .add_argument("--option-" + std::to_string(i) + "-" +
+                          std::to_string(j) + "-" + std::to_string(k))
+            .flag();
+      }
+    }
+  }
+  benchmark::report("help with groups, rendered", benchmark::measure(1, [&] {
+                      grouped.add_description("Grouped options");
+                      benchmark::do_not_optimize(grouped.help_text());
+                    }));
+}
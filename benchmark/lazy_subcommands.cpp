@@ -0,0 +1,59 @@
+// Measures starting a tool with many subcommands, which sets them all up and
+// parses a command line invoking one of them, with subparsers added eagerly
+// and registered with factories.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+
+constexpr std::size_t number_of_subcommands = 300;
+constexpr std::size_t number_of_options = 10;
+
+static void set_up(argparse::ArgumentParser &command, std::size_t index) {
+  command.add_description("Runs command number " + std::to_string(index));
+  for (std::size_t j = 0; j < number_of_options; ++j) {
+    command.add_argument("--option-" + std::to_string(j))
+        .help("sets option " + std::to_string(j))
+        .default_value(std::to_string(j));
+  }
+  command.add_argument("input").help("the file to read");
+}
+
+static std::string command_name(std::size_t index) {
+  return "command-" + std::to_string(index);
+}
+
+int main() {
+  benchmark::report("start up, eager subparsers", benchmark::measure(1, [] {
+                      argparse::ArgumentParser program("tool");
+                      std::list<argparse::ArgumentParser> commands;
+                      for (std::size_t i = 0; i < number_of_subcommands; ++i) {
+                        auto &command = commands.emplace_back(command_name(i));
+                        set_up(command, i);
+                        program.add_subparser(command);
+                      }
+                      program.parse_args(
+                          {"tool", "command-150", "--option-3", "x", "in"});
+                      benchmark::do_not_optimize(program);
+                    }));
+
+  benchmark::report("start up, lazy subparsers", benchmark::measure(1, [] {
+                      argparse::ArgumentParser program("tool");
+                      for (std::size_t i = 0; i < number_of_subcommands; ++i) {
+                        program.add_subparser(
+                            command_name(i),
+                            "Runs command number " + std::to_string(i), [i] {
+                              auto command =
+                                  std::make_unique<argparse::ArgumentParser>(
+                                      command_name(i));
+                              set_up(*command, i);
+                              return command;
+                            });
+                      }
+                      program.parse_args(
+                          {"tool", "command-150", "--option-3", "x", "in"});
+                      benchmark::do_not_optimize(program);
+                    }));
+}
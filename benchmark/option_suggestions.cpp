@@ -0,0 +1,48 @@
+// Measures suggesting the closest option for an unknown one and the closest
+// choice for a rejected value, in a parser with thousands of options, with
+// and without the index built by freeze().
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_options = 5000;
+
+namespace {
+
+void add_arguments(argparse::ArgumentParser &program) {
+  for (std::size_t i = 0; i < number_of_options; ++i) {
+    program.add_argument("--option-" + std::to_string(i * 7919));
+  }
+  auto &region = program.add_argument("--region");
+  for (std::size_t i = 0; i < number_of_options; ++i) {
+    region.add_choice("region-" + std::to_string(i * 7919));
+  }
+  region.choices();
+}
+
+void report_error(const char *name, const argparse::ArgumentParser &schema,
+                  const std::vector<std::string> &command_line) {
+  benchmark::report(name, benchmark::measure(1, [&] {
+                      auto result = schema.try_parse(command_line);
+                      benchmark::do_not_optimize(result.error().message());
+                    }));
+}
+
+} // namespace
+
+int main() {
+  argparse::ArgumentParser frozen("tool");
+  add_arguments(frozen);
+  frozen.freeze();
+  argparse::ArgumentParser unfrozen("tool");
+  add_arguments(unfrozen);
+
+  const std::vector<std::string> option_typo{"tool", "--optoin-7919", "x"};
+  const std::vector<std::string> choice_typo{"tool", "--region",
+                                             "regoin-7919"};
+  report_error("suggest an option, frozen", frozen, option_typo);
+  report_error("suggest an option, not frozen", unfrozen, option_typo);
+  report_error("suggest a choice", frozen, choice_typo);
+}
@@ -0,0 +1,48 @@
+// Measures the start of a short-lived tool: constructing its parser, with and
+// without the built-in -h/--help and -v/--version, and parsing a typical
+// command line, in heap allocations and ns.
+#include <argparse/argparse.hpp>
+#include <allocation_counter.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+static void construct(argparse::default_arguments add_args) {
+  argparse::ArgumentParser program("tool", "1.0", add_args);
+  benchmark::do_not_optimize(program);
+}
+
+static void start(argparse::default_arguments add_args) {
+  argparse::ArgumentParser program("tool", "1.0", add_args);
+  program.add_argument("--verbose").flag();
+  program.add_argument("-o", "--output").default_value(std::string("a.out"));
+  program.add_argument("-j", "--jobs").scan<'i', int>().default_value(1);
+  program.add_argument("inputs").nargs(argparse::nargs_pattern::at_least_one);
+  program.parse_args({"tool", "--verbose", "-o", "out", "-j", "4", "a.c",
+                      "b.c"});
+  benchmark::do_not_optimize(program.get<int>("--jobs"));
+}
+
+int main() {
+  const auto all = argparse::default_arguments::all;
+  const auto none = argparse::default_arguments::none;
+
+  std::cout << "allocations to construct, built-in arguments:    "
+            << benchmark::count_allocations([&] { construct(all); }) << '\n';
+  std::cout << "allocations to construct, no built-in arguments: "
+            << benchmark::count_allocations([&] { construct(none); }) << '\n';
+  std::cout << "allocations to start, built-in arguments:        "
+            << benchmark::count_allocations([&] { start(all); }) << '\n';
+  std::cout << "allocations to start, no built-in arguments:     "
+            << benchmark::count_allocations([&] { start(none); }) << '\n';
+
+  benchmark::report("construct, built-in arguments",
+                    benchmark::measure(1, [&] { construct(all); }));
+  benchmark::report("construct, no built-in arguments",
+                    benchmark::measure(1, [&] { construct(none); }));
+  benchmark::report("start, built-in arguments",
+                    benchmark::measure(1, [&] { start(all); }));
+  benchmark::report("start, no built-in arguments",
+                    benchmark::measure(1, [&] { start(none); }));
+}
@@ -0,0 +1,48 @@
+// Compares parsing the same command line with an ArgumentParser and with a
+// StaticParser generated from the same arguments.
+#include <argparse/static_parser.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr argparse::StaticSchema schema{
+    argparse::StaticArgument<int>("-j", "--jobs").default_value(1),
+    argparse::StaticArgument<bool>("-v", "--verbose").flag(),
+    argparse::StaticArgument<bool>("-q", "--quiet").flag(),
+    argparse::StaticArgument<double>("--timeout").default_value(30.0),
+    argparse::StaticArgument<std::string_view>("-o", "--output"),
+    argparse::StaticArgument<unsigned, 'x'>("--mask"),
+    argparse::StaticArgument<std::string_view>("input"),
+    argparse::StaticArgument<int>("sizes").nargs(1, 4)};
+
+int main() {
+  argparse::ArgumentParser program("tool", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_argument("-j", "--jobs").type<int>().default_value(1);
+  program.add_argument("-v", "--verbose").flag();
+  program.add_argument("-q", "--quiet").flag();
+  program.add_argument("--timeout").type<double>().default_value(30.0);
+  program.add_argument("-o", "--output");
+  program.add_argument("--mask").scan<'x', unsigned>();
+  program.add_argument("input");
+  program.add_argument("sizes").nargs(1, 4).type<int>();
+  program.freeze();
+
+  const std::vector<std::string> command_line{
+      "tool", "-vj",    "8",   "--timeout=2.5", "-o", "out.txt",
+      "--mask", "0xff", "in.txt", "1",          "2",  "3"};
+
+  benchmark::report("ArgumentParser parse per command line",
+                    benchmark::measure(1, [&] {
+                      auto result = program.parse(command_line);
+                      benchmark::do_not_optimize(result);
+                    }));
+  benchmark::report("StaticParser parse_args per command line",
+                    benchmark::measure(1, [&] {
+                      auto result = argparse::StaticParser<schema>::parse_args(
+                          command_line);
+                      benchmark::do_not_optimize(result);
+                    }));
+}
@@ -0,0 +1,54 @@
+// Measures setting up a parser whose help text is given as literals, copied
+// into std::strings or kept as StaticText views, in heap allocations and ns.
+#include <argparse/argparse.hpp>
+#include <allocation_counter.hpp>
+#include <benchmark.hpp>
+
+#include <array>
+#include <string>
+
+constexpr std::size_t number_of_arguments = 1000;
+
+// The names of the arguments, built before measuring
+const std::array<std::string, number_of_arguments> &names() {
+  static const auto names = [] {
+    std::array<std::string, number_of_arguments> result;
+    for (std::size_t i = 0; i < number_of_arguments; ++i) {
+      result[i] = "--option-" + std::to_string(i);
+    }
+    return result;
+  }();
+  return names;
+}
+
+template <typename Wrap> void set_up(Wrap wrap) {
+  argparse::ArgumentParser program("test", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_description(wrap("A program with many documented options"));
+  program.add_epilog(wrap("See the manual for the details of each option"));
+  program.add_group(wrap("Advanced options of the program"));
+  for (const auto &name : names()) {
+    program.add_argument(name)
+        .help(wrap("sets the value of one of the many options"))
+        .metavar(wrap("VALUE_OF_THE_OPTION"));
+  }
+  benchmark::do_not_optimize(program);
+}
+
+int main() {
+  names();
+  const auto owned = [](const char *text) { return std::string(text); };
+  const auto view = [](const char *text) {
+    return argparse::StaticText(text);
+  };
+
+  std::cout << "allocations with std::string: "
+            << benchmark::count_allocations([&] { set_up(owned); }) << '\n';
+  std::cout << "allocations with StaticText:  "
+            << benchmark::count_allocations([&] { set_up(view); }) << '\n';
+
+  benchmark::report("set up with std::string",
+                    benchmark::measure(1, [&] { set_up(owned); }));
+  benchmark::report("set up with StaticText",
+                    benchmark::measure(1, [&] { set_up(view); }));
+}
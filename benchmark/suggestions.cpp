@@ -0,0 +1,38 @@
+// Measures suggesting the closest subcommand for a mistyped one, in a parser
+// with many subcommands, and computing single edit distances.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_subcommands = 2000;
+
+int main() {
+  argparse::ArgumentParser program("tool");
+  std::list<argparse::ArgumentParser> subparsers;
+  for (std::size_t i = 0; i < number_of_subcommands; ++i) {
+    subparsers.emplace_back("command-" + std::to_string(i * 7919));
+    program.add_subparser(subparsers.back());
+  }
+  program.freeze();
+
+  const std::vector<std::string> typo{"tool", "comand-7919"};
+  benchmark::report("suggest a subcommand", benchmark::measure(1, [&] {
+                      try {
+                        auto result = program.parse(typo);
+                        benchmark::do_not_optimize(result);
+                      } catch (const std::runtime_error &e) {
+                        benchmark::do_not_optimize(e);
+                      }
+                    }));
+
+  const std::string s1 = "--output-directory";
+  const std::string s2 = "--outptu-direcotry";
+  benchmark::report("get_levenshtein_distance", benchmark::measure(1, [&] {
+                      benchmark::do_not_optimize(
+                          argparse::details::get_levenshtein_distance(s1, s2));
+                    }));
+}
@@ -0,0 +1,49 @@
+// Measures parsing command lines made mostly of values, where each token is
+// classified as a value or an option once, before the parser consumes it.
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_values = 2000;
+
+int main() {
+  argparse::ArgumentParser program("test", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_argument("--files").nargs(argparse::nargs_pattern::any);
+  program.add_argument("--numbers").nargs(argparse::nargs_pattern::any);
+  program.add_argument("-v").flag();
+  program.add_argument("-q").flag();
+  program.add_argument("--name");
+  program.freeze();
+
+  std::vector<std::string> command_line{"test", "--files"};
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    command_line.push_back("file-" + std::to_string(i) + ".txt");
+  }
+  command_line.emplace_back("--numbers");
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    command_line.push_back("-" + std::to_string(i) + ".5");
+  }
+  command_line.insert(command_line.end(), {"-vq", "--name=value"});
+
+  benchmark::report("parse per token",
+                    benchmark::measure(command_line.size(), [&] {
+                      auto result = program.parse(command_line);
+                      benchmark::do_not_optimize(result);
+                    }));
+
+  std::vector<std::string> options{"test"};
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    options.insert(options.end(), {"-v", "--name", "x", "-q"});
+  }
+  program["-v"].append();
+  program["-q"].append();
+  program["--name"].append();
+  benchmark::report("parse per token, options only",
+                    benchmark::measure(options.size(), [&] {
+                      auto result = program.parse(options);
+                      benchmark::do_not_optimize(result);
+                    }));
+}
@@ -0,0 +1,52 @@
+// Compares reading back the values of an argument with many values, stored
+// as one std::any per value (action) or in typed storage (scan<>()).
+#include <argparse/argparse.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+constexpr std::size_t number_of_values = 5000;
+
+int main() {
+  argparse::ArgumentParser program("values", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_argument("--any")
+      .nargs(argparse::nargs_pattern::any)
+      .action([](const std::string &value) { return std::stoi(value); });
+  program.add_argument("--typed")
+      .nargs(argparse::nargs_pattern::any)
+      .scan<'i', int>();
+
+  std::vector<std::string> command_line{"values", "--any"};
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    command_line.push_back(std::to_string(i));
+  }
+  command_line.emplace_back("--typed");
+  for (std::size_t i = 0; i < number_of_values; ++i) {
+    command_line.push_back(std::to_string(i));
+  }
+  program.parse_args(command_line);
+
+  benchmark::report("std::any get<std::vector<int>> per value",
+                    benchmark::measure(number_of_values, [&] {
+                      benchmark::do_not_optimize(
+                          program.get<std::vector<int>>("--any"));
+                    }));
+  benchmark::report("typed get<std::vector<int>> per value",
+                    benchmark::measure(number_of_values, [&] {
+                      benchmark::do_not_optimize(
+                          program.get<std::vector<int>>("--typed"));
+                    }));
+  benchmark::report("typed get_view<int> per value",
+                    benchmark::measure(number_of_values, [&] {
+                      benchmark::do_not_optimize(
+                          program.get_view<int>("--typed"));
+                    }));
+
+  benchmark::report("parse per value",
+                    benchmark::measure(command_line.size(), [&] {
+                      auto result = program.parse(command_line);
+                      benchmark::do_not_optimize(result);
+                    }));
+}
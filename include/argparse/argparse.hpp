@@ -36,9 +36,13 @@ SOFTWARE.
 #include <algorithm>
 #include <any>
 #include <array>
+#include <atomic>
 #include <set>
 #include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -46,6 +50,9 @@ SOFTWARE.
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <numeric>
 #include <optional>
 #include <sstream>
@@ -54,10 +61,27 @@ SOFTWARE.
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <variant>
 #include <vector>
 #include <filesystem>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
+
+#if !defined(ARGPARSE_HAS_MEMORY_RESOURCE) &&                                  \
+    defined(__cpp_lib_memory_resource)
+#define ARGPARSE_HAS_MEMORY_RESOURCE
+#endif
+
+// Floating point numbers are read with std::from_chars where the standard
+// library provides it, unless one of the strto* functions is replaced
+#if !defined(ARGPARSE_USE_STRTOD) &&                                           \
+    (defined(ARGPARSE_CUSTOM_STRTOF) || defined(ARGPARSE_CUSTOM_STRTOD) ||     \
+     defined(ARGPARSE_CUSTOM_STRTOLD) || !defined(__cpp_lib_to_chars))
+#define ARGPARSE_USE_STRTOD
 #endif
 
 #ifndef ARGPARSE_CUSTOM_STRTOF
@@ -72,10 +96,47 @@ SOFTWARE.
 #define ARGPARSE_CUSTOM_STRTOLD strtold
 #endif
 
+// With ARGPARSE_COMPILED_LIB, the non-template core of the parser is compiled
+// once into the argparse_lib library, whose source defines
+// ARGPARSE_IMPLEMENTATION, instead of in every translation unit
+#ifdef ARGPARSE_COMPILED_LIB
+#define ARGPARSE_INLINE
+#else
+#define ARGPARSE_INLINE inline
+#endif
+
 namespace argparse {
 
+enum class nargs_pattern { optional, any, at_least_one };
+
+/* Text with static storage duration, such as a string literal, of which a
+ * parser keeps a view instead of a copy, e.g.
+ *   .help(argparse::StaticText("shows help message and exits"))
+ */
+struct StaticText {
+  constexpr explicit StaticText(std::string_view text) : view(text) {}
+
+  std::string_view view;
+};
+
 namespace details { // namespace for helper methods
 
+// Allocator of the containers of a parser and of its parse results: a
+// std::pmr::polymorphic_allocator when the standard library provides one.
+#ifdef ARGPARSE_HAS_MEMORY_RESOURCE
+template <typename T> using allocator = std::pmr::polymorphic_allocator<T>;
+#else
+template <typename T> using allocator = std::allocator<T>;
+#endif
+
+template <typename T> using vector = std::vector<T, allocator<T>>;
+
+template <typename T> using list = std::list<T, allocator<T>>;
+
+template <typename Key, typename Value>
+using map = std::map<Key, Value, std::less<>,
+                     allocator<std::pair<const Key, Value>>>;
+
 template <typename T, typename = void>
 struct HasContainerTraits : std::false_type {};
 
@@ -92,6 +153,30 @@ struct HasContainerTraits<
 template <typename T>
 inline constexpr bool IsContainer = HasContainerTraits<T>::value;
 
+template <typename T, typename = void>
+struct HasPushBackTraits : std::false_type {};
+
+template <typename T>
+struct HasPushBackTraits<
+    T, std::void_t<decltype(std::declval<T>().push_back(
+           std::declval<typename T::value_type>()))>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool HasPushBack = HasPushBackTraits<T>::value;
+
+template <typename Converter, typename T, typename = void>
+struct HasTryParseTraits : std::false_type {};
+
+template <typename Converter, typename T>
+struct HasTryParseTraits<
+    Converter, T,
+    std::void_t<decltype(Converter::try_parse(std::declval<std::string_view>(),
+                                              std::declval<T &>()))>>
+    : std::true_type {};
+
+template <typename Converter, typename T>
+inline constexpr bool HasTryParse = HasTryParseTraits<Converter, T>::value;
+
 template <typename T, typename = void>
 struct HasStreamableTraits : std::false_type {};
 
@@ -188,6 +273,144 @@ constexpr decltype(auto) apply_plus_one(F &&f, Tuple &&t, Extra &&x) {
           std::tuple_size_v<std::remove_reference_t<Tuple>>>{});
 }
 
+/* A copyable callable like std::function, which stores callables of up to
+ * Capacity bytes, e.g. a lambda capturing a few references, in place instead
+ * of allocating them. Larger callables are allocated.
+ */
+template <typename Signature, std::size_t Capacity = 3 * sizeof(void *)>
+class InlineFunction;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+  template <typename F>
+  static constexpr bool is_inline =
+      sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<F>;
+
+public:
+  InlineFunction() noexcept = default;
+
+  template <typename F,
+            std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, InlineFunction> &&
+                std::is_invocable_r_v<R, std::decay_t<F> &, Args...>> * =
+                nullptr>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  InlineFunction(F &&f) {
+    using Callable = std::decay_t<F>;
+    if constexpr (is_inline<Callable>) {
+      new (m_storage) Callable(std::forward<F>(f));
+    } else {
+      new (m_storage) Callable *(new Callable(std::forward<F>(f)));
+    }
+    m_ops = &ops<Callable>;
+  }
+
+  InlineFunction(const InlineFunction &other) : m_ops(other.m_ops) {
+    if (m_ops != nullptr) {
+      m_ops->copy(other.m_storage, m_storage);
+    }
+  }
+
+  InlineFunction(InlineFunction &&other) noexcept : m_ops(other.m_ops) {
+    if (m_ops != nullptr) {
+      m_ops->move(other.m_storage, m_storage);
+      other.m_ops = nullptr;
+    }
+  }
+
+  InlineFunction &operator=(const InlineFunction &other) {
+    if (this != &other) {
+      InlineFunction copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  InlineFunction &operator=(InlineFunction &&other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.m_ops != nullptr) {
+        other.m_ops->move(other.m_storage, m_storage);
+        m_ops = std::exchange(other.m_ops, nullptr);
+      }
+    }
+    return *this;
+  }
+
+  ~InlineFunction() { reset(); }
+
+  explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+  R operator()(Args... args) const {
+    return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+  }
+
+private:
+  struct Ops {
+    R (*invoke)(void *, Args &&...);
+    void (*copy)(const void *, void *);
+    // Moves the callable and destroys the source
+    void (*move)(void *, void *) noexcept;
+    void (*destroy)(void *) noexcept;
+  };
+
+  template <typename F> static F &target(void *storage) noexcept {
+    if constexpr (is_inline<F>) {
+      return *static_cast<F *>(storage);
+    } else {
+      return **static_cast<F **>(storage);
+    }
+  }
+
+  template <typename F> static R invoke(void *storage, Args &&...args) {
+    if constexpr (std::is_void_v<R>) {
+      std::invoke(target<F>(storage), std::forward<Args>(args)...);
+    } else {
+      return std::invoke(target<F>(storage), std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename F> static void copy(const void *from, void *to) {
+    auto &source = target<F>(const_cast<void *>(from));
+    if constexpr (is_inline<F>) {
+      new (to) F(source);
+    } else {
+      new (to) F *(new F(source));
+    }
+  }
+
+  template <typename F> static void move(void *from, void *to) noexcept {
+    if constexpr (is_inline<F>) {
+      new (to) F(std::move(target<F>(from)));
+      target<F>(from).~F();
+    } else {
+      new (to) F *(*static_cast<F **>(from));
+    }
+  }
+
+  template <typename F> static void destroy(void *storage) noexcept {
+    if constexpr (is_inline<F>) {
+      target<F>(storage).~F();
+    } else {
+      delete &target<F>(storage);
+    }
+  }
+
+  template <typename F>
+  static constexpr Ops ops{&invoke<F>, &copy<F>, &move<F>, &destroy<F>};
+
+  void reset() noexcept {
+    if (m_ops != nullptr) {
+      m_ops->destroy(m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+  const Ops *m_ops = nullptr;
+};
+
 constexpr auto pointer_range(std::string_view s) noexcept {
   return std::tuple(s.data(), s.data() + s.size());
 }
@@ -237,127 +460,160 @@ constexpr auto consume_hex_prefix(std::string_view s)
   return {false, s};
 }
 
+/* Throws the error of reading the integer s, whose digits are rest, where
+ * std::from_chars gave ec, or no error but did not read all of rest. The
+ * message starts with "Failed to parse 's' as <base_name>" if base_name is
+ * given.
+ */
+[[noreturn]] inline void throw_from_chars_error(std::string_view s,
+                                                std::string_view rest,
+                                                std::errc ec,
+                                                const char *base_name) {
+  std::string message;
+  if (base_name != nullptr) {
+    message = "Failed to parse '" + std::string(s) + "' as " + base_name + ": ";
+  }
+  if (ec == std::errc::result_out_of_range) {
+    throw std::range_error{message + "'" + std::string(rest) +
+                           "' not representable"};
+  }
+  throw std::invalid_argument{
+      message + "pattern '" + std::string(rest) +
+      (ec == std::errc() ? "' does not match to the end" : "' not found")};
+}
+
+// Reads the digits rest of the integer s, see throw_from_chars_error()
 template <class T, auto Param>
-inline auto do_from_chars(std::string_view s) -> T {
+inline auto do_from_chars(std::string_view s, std::string_view rest,
+                          const char *base_name = nullptr) -> T {
   T x{0};
+  auto [first, last] = pointer_range(rest);
+  auto [ptr, ec] = std::from_chars(first, last, x, Param);
+  if (ec == std::errc() && ptr == last) {
+    return x;
+  }
+  throw_from_chars_error(s, rest, ec, base_name);
+}
+
+// Like do_from_chars, but returns the error instead of throwing it
+template <class T, auto Param>
+inline auto try_from_chars(std::string_view s, T &x) noexcept -> std::errc {
   auto [first, last] = pointer_range(s);
   auto [ptr, ec] = std::from_chars(first, last, x, Param);
-  if (ec == std::errc()) {
-    if (ptr == last) {
-      return x;
-    }
-    throw std::invalid_argument{"pattern '" + std::string(s) +
-                                "' does not match to the end"};
+  if (ec == std::errc() && ptr != last) {
+    return std::errc::invalid_argument;
   }
-  if (ec == std::errc::invalid_argument) {
-    throw std::invalid_argument{"pattern '" + std::string(s) + "' not found"};
+  return ec;
+}
+
+/* The prefix, digits and name of the base of the integer s in the base given
+ * by Param, as the parse_integer converter reads it.
+ */
+struct IntegerLiteral {
+  int radix;
+  std::string_view rest;
+  const char *base_name;
+};
+
+inline IntegerLiteral integer_literal(std::string_view s, int param) {
+  if (param == radix_16) {
+    return {radix_16, consume_hex_prefix(s).rest, "hexadecimal"};
   }
-  if (ec == std::errc::result_out_of_range) {
-    throw std::range_error{"'" + std::string(s) + "' not representable"};
+  if (param == radix_2) {
+    return {radix_2, consume_binary_prefix(s).rest, nullptr};
   }
-  return x; // unreachable
+  if (param != 0) {
+    return {param, s, nullptr};
+  }
+  if (auto [ok, rest] = consume_hex_prefix(s); ok) {
+    return {radix_16, rest, "hexadecimal"};
+  }
+  if (auto [ok, rest] = consume_binary_prefix(s); ok) {
+    return {radix_2, rest, "binary"};
+  }
+  if (starts_with("0"sv, s)) {
+    return {radix_8, s, "octal"};
+  }
+  return {radix_10, s, "decimal integer"};
 }
 
-template <class T, auto Param = 0> struct parse_number {
+// Conversion of a value to the integer T in the base given by Param, with
+// the prefix 0x or 0b where Param is 0 (for any base) or 16
+template <class T, auto Param = 0> struct parse_integer {
   auto operator()(std::string_view s) -> T {
-    return do_from_chars<T, Param>(s);
+    return do_from_chars<T, Param>(s, s);
+  }
+
+  static auto try_parse(std::string_view s, T &x) noexcept -> std::errc {
+    return try_from_chars<T, Param>(s, x);
   }
 };
 
-template <class T> struct parse_number<T, radix_2> {
+template <class T> struct parse_integer<T, radix_2> {
   auto operator()(std::string_view s) -> T {
     if (auto [ok, rest] = consume_binary_prefix(s); ok) {
-      return do_from_chars<T, radix_2>(rest);
+      return do_from_chars<T, radix_2>(s, rest);
     }
     throw std::invalid_argument{"pattern not found"};
   }
-};
 
-template <class T> struct parse_number<T, radix_16> {
-  auto operator()(std::string_view s) -> T {
-    if (starts_with("0x"sv, s) || starts_with("0X"sv, s)) {
-      if (auto [ok, rest] = consume_hex_prefix(s); ok) {
-        try {
-          return do_from_chars<T, radix_16>(rest);
-        } catch (const std::invalid_argument &err) {
-          throw std::invalid_argument("Failed to parse '" + std::string(s) +
-                                      "' as hexadecimal: " + err.what());
-        } catch (const std::range_error &err) {
-          throw std::range_error("Failed to parse '" + std::string(s) +
-                                 "' as hexadecimal: " + err.what());
-        }
-      }
-    } else {
-      // Allow passing hex numbers without prefix
-      // Shape 'x' already has to be specified
-      try {
-        return do_from_chars<T, radix_16>(s);
-      } catch (const std::invalid_argument &err) {
-        throw std::invalid_argument("Failed to parse '" + std::string(s) +
-                                    "' as hexadecimal: " + err.what());
-      } catch (const std::range_error &err) {
-        throw std::range_error("Failed to parse '" + std::string(s) +
-                               "' as hexadecimal: " + err.what());
-      }
+  static auto try_parse(std::string_view s, T &x) noexcept -> std::errc {
+    if (auto [ok, rest] = consume_binary_prefix(s); ok) {
+      return try_from_chars<T, radix_2>(rest, x);
     }
-
-    throw std::invalid_argument{"pattern '" + std::string(s) +
-                                "' not identified as hexadecimal"};
+    return std::errc::invalid_argument;
   }
 };
 
-template <class T> struct parse_number<T> {
+template <class T> struct parse_integer<T, radix_16> {
+  static auto try_parse(std::string_view s, T &x) noexcept -> std::errc {
+    return try_from_chars<T, radix_16>(consume_hex_prefix(s).rest, x);
+  }
+
+  // Hex numbers are also given without prefix, as the shape 'x' is
   auto operator()(std::string_view s) -> T {
-    auto [ok, rest] = consume_hex_prefix(s);
-    if (ok) {
-      try {
-        return do_from_chars<T, radix_16>(rest);
-      } catch (const std::invalid_argument &err) {
-        throw std::invalid_argument("Failed to parse '" + std::string(s) +
-                                    "' as hexadecimal: " + err.what());
-      } catch (const std::range_error &err) {
-        throw std::range_error("Failed to parse '" + std::string(s) +
-                               "' as hexadecimal: " + err.what());
-      }
-    }
+    return do_from_chars<T, radix_16>(s, consume_hex_prefix(s).rest,
+                                      "hexadecimal");
+  }
+};
 
-    auto [ok_binary, rest_binary] = consume_binary_prefix(s);
-    if (ok_binary) {
-      try {
-        return do_from_chars<T, radix_2>(rest_binary);
-      } catch (const std::invalid_argument &err) {
-        throw std::invalid_argument("Failed to parse '" + std::string(s) +
-                                    "' as binary: " + err.what());
-      } catch (const std::range_error &err) {
-        throw std::range_error("Failed to parse '" + std::string(s) +
-                               "' as binary: " + err.what());
-      }
+template <class T> struct parse_integer<T> {
+  static auto try_parse(std::string_view s, T &x) noexcept -> std::errc {
+    if (auto [ok, rest] = consume_hex_prefix(s); ok) {
+      return try_from_chars<T, radix_16>(rest, x);
+    }
+    if (auto [ok, rest] = consume_binary_prefix(s); ok) {
+      return try_from_chars<T, radix_2>(rest, x);
     }
-
     if (starts_with("0"sv, s)) {
-      try {
-        return do_from_chars<T, radix_8>(rest);
-      } catch (const std::invalid_argument &err) {
-        throw std::invalid_argument("Failed to parse '" + std::string(s) +
-                                    "' as octal: " + err.what());
-      } catch (const std::range_error &err) {
-        throw std::range_error("Failed to parse '" + std::string(s) +
-                               "' as octal: " + err.what());
-      }
+      return try_from_chars<T, radix_8>(s, x);
     }
+    return try_from_chars<T, radix_10>(s, x);
+  }
 
-    try {
-      return do_from_chars<T, radix_10>(rest);
-    } catch (const std::invalid_argument &err) {
-      throw std::invalid_argument("Failed to parse '" + std::string(s) +
-                                  "' as decimal integer: " + err.what());
-    } catch (const std::range_error &err) {
-      throw std::range_error("Failed to parse '" + std::string(s) +
-                             "' as decimal integer: " + err.what());
+  auto operator()(std::string_view s) -> T {
+    const auto literal = integer_literal(s, 0);
+    switch (literal.radix) {
+    case radix_16:
+      return do_from_chars<T, radix_16>(s, literal.rest, literal.base_name);
+    case radix_2:
+      return do_from_chars<T, radix_2>(s, literal.rest, literal.base_name);
+    case radix_8:
+      return do_from_chars<T, radix_8>(s, literal.rest, literal.base_name);
+    default:
+      return do_from_chars<T, radix_10>(s, literal.rest, literal.base_name);
     }
   }
 };
 
+/* The parse_number converters throw an exception describing why a value is
+ * invalid. Their try_parse() reads the same values, but only returns
+ * std::errc::invalid_argument or std::errc::result_out_of_range, as cheaply
+ * as a valid value.
+ */
+template <class T, auto Param = 0>
+struct parse_number : parse_integer<T, Param> {};
+
 namespace {
 
 template <class T> inline const auto generic_strtod = nullptr;
@@ -391,8 +647,112 @@ template <class T> inline auto do_strtod(std::string const &s) -> T {
   return x; // unreachable
 }
 
+#ifndef ARGPARSE_USE_STRTOD
+// std::from_chars of long double is slower than strtold in libstdc++, which
+// reads it through the C library
+template <class T>
+inline constexpr bool reads_with_strtod = std::is_same_v<T, long double>;
+#endif
+
+// Like do_strtod, but returns the error instead of throwing it
+template <class T>
+inline auto try_strtod(std::string_view s, T &x) -> std::errc {
+  if (!s.empty() &&
+      (isspace(static_cast<unsigned char>(s[0])) || s[0] == '+')) {
+    return std::errc::invalid_argument;
+  }
+#ifndef ARGPARSE_USE_STRTOD
+  if constexpr (!reads_with_strtod<T>) {
+    if (s.empty()) {
+      x = T{}; // as strtod reads it
+      return std::errc();
+    }
+    auto [first, last] = pointer_range(s);
+    auto format = std::chars_format::general;
+    if (auto [ok, rest] = consume_hex_prefix(s); ok) {
+      if (rest.empty() || rest[0] == '-' || rest[0] == '+' ||
+          isspace(static_cast<unsigned char>(rest[0]))) {
+        return std::errc::invalid_argument;
+      }
+      first = rest.data();
+      format = std::chars_format::hex;
+    }
+    auto [ptr, ec] = std::from_chars(first, last, x, format);
+    if (ec == std::errc() && ptr != last) {
+      return std::errc::invalid_argument;
+    }
+    return ec;
+  }
+#endif
+  const std::string value(s);
+  auto [first, last] = pointer_range(value);
+  char *ptr;
+  errno = 0;
+  x = generic_strtod<T>(first, &ptr);
+  if (errno == ERANGE) {
+    return std::errc::result_out_of_range;
+  }
+  return errno == 0 && ptr == last ? std::errc() : std::errc::invalid_argument;
+}
+
+/* Reads a floating point number like strtod does, but independently of the
+ * locale and without copying s when std::from_chars is available. A
+ * hexfloat is given with its 0x prefix.
+ */
+template <class T> inline auto do_strtod(std::string_view s) -> T {
+#ifdef ARGPARSE_USE_STRTOD
+  return do_strtod<T>(std::string(s));
+#else
+  if constexpr (reads_with_strtod<T>) {
+    return do_strtod<T>(std::string(s));
+  }
+  if (s.empty()) {
+    return T{}; // as strtod reads it
+  }
+  auto [first, last] = pointer_range(s);
+  auto format = std::chars_format::general;
+  if (auto [ok, rest] = consume_hex_prefix(s); ok) {
+    // strtod reads the 0 of 0x alone when no hexfloat follows
+    if (rest.empty() || rest[0] == '-' || rest[0] == '+' ||
+        isspace(static_cast<unsigned char>(rest[0]))) {
+      throw std::invalid_argument{"pattern '" + std::string(s) +
+                                  "' does not match to the end"};
+    }
+    first = rest.data();
+    format = std::chars_format::hex;
+  }
+
+  T x{};
+  auto [ptr, ec] = std::from_chars(first, last, x, format);
+  if (ec == std::errc()) {
+    if (ptr == last) {
+      return x;
+    }
+    throw std::invalid_argument{"pattern '" + std::string(s) +
+                                "' does not match to the end"};
+  }
+  if (ec == std::errc::result_out_of_range) {
+    throw std::range_error{"'" + std::string(s) + "' not representable"};
+  }
+  // The messages of do_strtod(std::string), where strtod reads no number
+  if (isspace(static_cast<unsigned char>(s[0])) || s[0] == '+') {
+    throw std::invalid_argument{"pattern '" + std::string(s) + "' not found"};
+  }
+  throw std::invalid_argument{"pattern '" + std::string(s) +
+                              "' does not match to the end"};
+#endif
+}
+
 template <class T> struct parse_number<T, chars_format::general> {
-  auto operator()(std::string const &s) -> T {
+  static auto try_parse(std::string_view s, T &x) -> std::errc {
+    if (consume_hex_prefix(s).is_hexadecimal ||
+        consume_binary_prefix(s).is_binary) {
+      return std::errc::invalid_argument;
+    }
+    return try_strtod(s, x);
+  }
+
+  auto operator()(std::string_view s) -> T {
     if (auto r = consume_hex_prefix(s); r.is_hexadecimal) {
       throw std::invalid_argument{
           "chars_format::general does not parse hexfloat"};
@@ -405,17 +765,24 @@ template <class T> struct parse_number<T, chars_format::general> {
     try {
       return do_strtod<T>(s);
     } catch (const std::invalid_argument &err) {
-      throw std::invalid_argument("Failed to parse '" + s +
+      throw std::invalid_argument("Failed to parse '" + std::string(s) +
                                   "' as number: " + err.what());
     } catch (const std::range_error &err) {
-      throw std::range_error("Failed to parse '" + s +
+      throw std::range_error("Failed to parse '" + std::string(s) +
                              "' as number: " + err.what());
     }
   }
 };
 
 template <class T> struct parse_number<T, chars_format::hex> {
-  auto operator()(std::string const &s) -> T {
+  static auto try_parse(std::string_view s, T &x) -> std::errc {
+    if (!consume_hex_prefix(s).is_hexadecimal) {
+      return std::errc::invalid_argument;
+    }
+    return try_strtod(s, x);
+  }
+
+  auto operator()(std::string_view s) -> T {
     if (auto r = consume_hex_prefix(s); !r.is_hexadecimal) {
       throw std::invalid_argument{"chars_format::hex parses hexfloat"};
     }
@@ -426,17 +793,24 @@ template <class T> struct parse_number<T, chars_format::hex> {
     try {
       return do_strtod<T>(s);
     } catch (const std::invalid_argument &err) {
-      throw std::invalid_argument("Failed to parse '" + s +
+      throw std::invalid_argument("Failed to parse '" + std::string(s) +
                                   "' as hexadecimal: " + err.what());
     } catch (const std::range_error &err) {
-      throw std::range_error("Failed to parse '" + s +
+      throw std::range_error("Failed to parse '" + std::string(s) +
                              "' as hexadecimal: " + err.what());
     }
   }
 };
 
 template <class T> struct parse_number<T, chars_format::binary> {
-  auto operator()(std::string const &s) -> T {
+  static auto try_parse(std::string_view s, T &x) -> std::errc {
+    if (!consume_binary_prefix(s).is_binary) {
+      return std::errc::invalid_argument;
+    }
+    return try_strtod(s, x);
+  }
+
+  auto operator()(std::string_view s) -> T {
     if (auto r = consume_hex_prefix(s); r.is_hexadecimal) {
       throw std::invalid_argument{
           "chars_format::binary does not parse hexfloat"};
@@ -450,7 +824,16 @@ template <class T> struct parse_number<T, chars_format::binary> {
 };
 
 template <class T> struct parse_number<T, chars_format::scientific> {
-  auto operator()(std::string const &s) -> T {
+  static auto try_parse(std::string_view s, T &x) -> std::errc {
+    if (consume_hex_prefix(s).is_hexadecimal ||
+        consume_binary_prefix(s).is_binary ||
+        s.find_first_of("eE") == std::string_view::npos) {
+      return std::errc::invalid_argument;
+    }
+    return try_strtod(s, x);
+  }
+
+  auto operator()(std::string_view s) -> T {
     if (auto r = consume_hex_prefix(s); r.is_hexadecimal) {
       throw std::invalid_argument{
           "chars_format::scientific does not parse hexfloat"};
@@ -459,7 +842,7 @@ template <class T> struct parse_number<T, chars_format::scientific> {
       throw std::invalid_argument{
           "chars_format::scientific does not parse binfloat"};
     }
-    if (s.find_first_of("eE") == std::string::npos) {
+    if (s.find_first_of("eE") == std::string_view::npos) {
       throw std::invalid_argument{
           "chars_format::scientific requires exponent part"};
     }
@@ -467,17 +850,26 @@ template <class T> struct parse_number<T, chars_format::scientific> {
     try {
       return do_strtod<T>(s);
     } catch (const std::invalid_argument &err) {
-      throw std::invalid_argument("Failed to parse '" + s +
+      throw std::invalid_argument("Failed to parse '" + std::string(s) +
                                   "' as scientific notation: " + err.what());
     } catch (const std::range_error &err) {
-      throw std::range_error("Failed to parse '" + s +
+      throw std::range_error("Failed to parse '" + std::string(s) +
                              "' as scientific notation: " + err.what());
     }
   }
 };
 
 template <class T> struct parse_number<T, chars_format::fixed> {
-  auto operator()(std::string const &s) -> T {
+  static auto try_parse(std::string_view s, T &x) -> std::errc {
+    if (consume_hex_prefix(s).is_hexadecimal ||
+        consume_binary_prefix(s).is_binary ||
+        s.find_first_of("eE") != std::string_view::npos) {
+      return std::errc::invalid_argument;
+    }
+    return try_strtod(s, x);
+  }
+
+  auto operator()(std::string_view s) -> T {
     if (auto r = consume_hex_prefix(s); r.is_hexadecimal) {
       throw std::invalid_argument{
           "chars_format::fixed does not parse hexfloat"};
@@ -486,7 +878,7 @@ template <class T> struct parse_number<T, chars_format::fixed> {
       throw std::invalid_argument{
           "chars_format::fixed does not parse binfloat"};
     }
-    if (s.find_first_of("eE") != std::string::npos) {
+    if (s.find_first_of("eE") != std::string_view::npos) {
       throw std::invalid_argument{
           "chars_format::fixed does not parse exponent part"};
     }
@@ -494,28 +886,179 @@ template <class T> struct parse_number<T, chars_format::fixed> {
     try {
       return do_strtod<T>(s);
     } catch (const std::invalid_argument &err) {
-      throw std::invalid_argument("Failed to parse '" + s +
+      throw std::invalid_argument("Failed to parse '" + std::string(s) +
                                   "' as fixed notation: " + err.what());
     } catch (const std::range_error &err) {
-      throw std::range_error("Failed to parse '" + s +
+      throw std::range_error("Failed to parse '" + std::string(s) +
                              "' as fixed notation: " + err.what());
     }
   }
 };
 
+template <class T> struct construct_from_string {
+  auto operator()(std::string_view s) -> T { return T(std::string(s)); }
+};
+
+// Conversion of a value to T when no format is given: integers are decimal,
+// floating point numbers in the general format.
+template <class T, typename = void>
+struct default_converter : construct_from_string<T> {};
+
+template <class T>
+struct default_converter<T, std::enable_if_t<standard_integer<T>>>
+    : parse_number<T, radix_10> {};
+
+template <class T>
+struct default_converter<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    : parse_number<T, chars_format::general> {};
+
+/* Reads the decimal digits of s into value, eight at a time in a 64-bit
+ * word where the byte order allows it.
+ * @returns false if one of the characters is not a digit
+ */
+inline bool parse_digits(std::string_view s, std::uint64_t &value) {
+  std::uint64_t result = 0;
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ||   \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+  constexpr std::uint64_t zeros = 0x3030303030303030;
+  constexpr std::uint64_t high_nibbles = 0xF0F0F0F0F0F0F0F0;
+  if (s.size() >= 8) {
+    // The first s.size() % 8 digits are shifted up behind '0's in the lowest
+    // bytes, so that the following words are full
+    const auto head = s.size() % 8;
+    for (std::size_t i = 0; i < s.size(); i = (i == 0 && head != 0) ? head : i + 8) {
+      std::uint64_t chunk = 0;
+      std::memcpy(&chunk, s.data() + i, sizeof(chunk));
+      if (i == 0 && head != 0) {
+        chunk = (chunk << (64 - 8 * head)) | (zeros >> (8 * head));
+      }
+      // Every byte in 0x30-0x39, i.e. 0x3? that stays 0x3? when adding 6
+      if ((chunk & high_nibbles) != zeros ||
+          ((chunk + 0x0606060606060606) & high_nibbles) != zeros) {
+        return false;
+      }
+      // The first digit is in the lowest byte
+      chunk -= zeros;
+      chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+      chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+      chunk = (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFF;
+      result = result * 100000000 + chunk;
+    }
+    value = result;
+    return true;
+  }
+#endif
+  for (const char c : s) {
+    const auto digit = static_cast<unsigned char>(c - '0');
+    if (digit > 9) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  value = result;
+  return true;
+}
+
+/* Appends the decimal integers of [first, last) to values, up to the first
+ * token that is not an optional minus sign followed by digits without a
+ * leading zero, or that does not fit in T.
+ * @returns The position of that token, last if all were converted
+ */
+template <class T>
+const std::string_view *parse_decimal_run(const std::string_view *first,
+                                          const std::string_view *last,
+                                          std::vector<T> &values) {
+  constexpr std::size_t max_digits =
+      (std::min)(std::numeric_limits<T>::digits10 + 1, 19);
+  constexpr auto max = static_cast<std::uint64_t>((std::numeric_limits<T>::max)());
+  values.reserve(values.size() + static_cast<std::size_t>(last - first));
+  for (; first != last; ++first) {
+    auto digits = *first;
+    const bool negative =
+        std::is_signed_v<T> && digits.size() > 1 && digits.front() == '-';
+    digits.remove_prefix(negative ? 1 : 0);
+    std::uint64_t magnitude = 0;
+    if (digits.empty() || digits.size() > max_digits ||
+        (digits.front() == '0' && digits.size() > 1) ||
+        !parse_digits(digits, magnitude) ||
+        magnitude > max + (negative ? 1 : 0)) {
+      return first;
+    }
+    if constexpr (std::is_signed_v<T>) {
+      // -max - 1 without overflowing
+      values.push_back(negative ? static_cast<T>(-static_cast<T>(magnitude - 1) - 1)
+                                : static_cast<T>(magnitude));
+    } else {
+      values.push_back(static_cast<T>(magnitude));
+    }
+  }
+  return last;
+}
+
+// Conversion of a value to T following the Shape of scan<Shape, T>()
+template <char Shape, class T> auto make_scan_converter() {
+  auto is_one_of = [](char c, auto... x) constexpr {
+    return ((c == x) || ...);
+  };
+
+  if constexpr (is_one_of(Shape, 'd') && standard_integer<T>) {
+    return parse_number<T, radix_10>();
+  } else if constexpr (is_one_of(Shape, 'i') && standard_integer<T>) {
+    return parse_number<T>();
+  } else if constexpr (is_one_of(Shape, 'u') &&
+                       standard_unsigned_integer<T>) {
+    return parse_number<T, radix_10>();
+  } else if constexpr (is_one_of(Shape, 'b') &&
+                       standard_unsigned_integer<T>) {
+    return parse_number<T, radix_2>();
+  } else if constexpr (is_one_of(Shape, 'o') &&
+                       standard_unsigned_integer<T>) {
+    return parse_number<T, radix_8>();
+  } else if constexpr (is_one_of(Shape, 'x', 'X') &&
+                       standard_unsigned_integer<T>) {
+    return parse_number<T, radix_16>();
+  } else if constexpr (is_one_of(Shape, 'a', 'A') &&
+                       std::is_floating_point_v<T>) {
+    return parse_number<T, chars_format::hex>();
+  } else if constexpr (is_one_of(Shape, 'e', 'E') &&
+                       std::is_floating_point_v<T>) {
+    return parse_number<T, chars_format::scientific>();
+  } else if constexpr (is_one_of(Shape, 'f', 'F') &&
+                       std::is_floating_point_v<T>) {
+    return parse_number<T, chars_format::fixed>();
+  } else if constexpr (is_one_of(Shape, 'g', 'G') &&
+                       std::is_floating_point_v<T>) {
+    return parse_number<T, chars_format::general>();
+  } else {
+    static_assert(alignof(T) == 0, "No scan specification for T");
+  }
+}
+
+template <char Shape, class T>
+using scan_converter = decltype(make_scan_converter<Shape, T>());
+
 template <typename StrIt>
 std::string join(StrIt first, StrIt last, const std::string &separator) {
   if (first == last) {
     return "";
   }
-  std::stringstream value;
-  value << *first;
-  ++first;
-  while (first != last) {
-    value << separator << *first;
+  if constexpr (std::is_convertible_v<decltype(*first), std::string_view>) {
+    std::string value{std::string_view{*first}};
+    while (++first != last) {
+      value += separator;
+      value += std::string_view{*first};
+    }
+    return value;
+  } else {
+    std::stringstream value;
+    value << *first;
     ++first;
+    while (first != last) {
+      value << separator << *first;
+      ++first;
+    }
+    return value.str();
   }
-  return value.str();
 }
 
 template <typename T> struct can_invoke_to_string {
@@ -536,49 +1079,613 @@ template <typename T> struct IsChoiceTypeSupported {
                             std::is_same<CleanType, const char *>::value;
 };
 
-template <typename StringType>
-std::size_t get_levenshtein_distance(const StringType &s1,
-                                     const StringType &s2) {
-  std::vector<std::vector<std::size_t>> dp(
-      s1.size() + 1, std::vector<std::size_t>(s2.size() + 1, 0));
-
-  for (std::size_t i = 0; i <= s1.size(); ++i) {
-    for (std::size_t j = 0; j <= s2.size(); ++j) {
-      if (i == 0) {
-        dp[i][j] = j;
-      } else if (j == 0) {
-        dp[i][j] = i;
-      } else if (s1[i - 1] == s2[j - 1]) {
-        dp[i][j] = dp[i - 1][j - 1];
-      } else {
-        dp[i][j] = 1 + std::min<std::size_t>({dp[i - 1][j], dp[i][j - 1], dp[i - 1][j - 1]});
+/*
+ * A string of at most 64 characters, prepared to compute its Levenshtein
+ * distance to many other strings. The columns of the dynamic programming
+ * matrix are computed as bit vectors (Myers' algorithm, as formulated by
+ * Hyyro), with one bit per character of the pattern.
+ */
+class LevenshteinPattern {
+public:
+  static constexpr std::size_t max_size = 64;
+
+  explicit LevenshteinPattern(std::string_view pattern)
+      : m_size(pattern.size()) {
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+      m_peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+    }
+  }
+
+  // The distance to text, or max_distance + 1 if it is larger
+  std::size_t distance(std::string_view text, std::size_t max_distance) const {
+    max_distance = std::min(max_distance, std::max(m_size, text.size()));
+    const auto too_far = max_distance + 1;
+    const auto length_difference =
+        m_size > text.size() ? m_size - text.size() : text.size() - m_size;
+    if (length_difference > max_distance) {
+      return too_far;
+    }
+    if (m_size == 0) {
+      return text.size();
+    }
+
+    const auto last_row = std::uint64_t{1} << (m_size - 1);
+    // The vertical differences of the current column, +1 and -1
+    std::uint64_t pv = ~std::uint64_t{0};
+    std::uint64_t mv = 0;
+    std::size_t distance = m_size;
+    for (std::size_t j = 0; j < text.size(); ++j) {
+      const auto eq = m_peq[static_cast<unsigned char>(text[j])];
+      const auto xv = eq | mv;
+      const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+      // The horizontal differences, +1 and -1
+      auto ph = mv | ~(xh | pv);
+      auto mh = pv & xh;
+      if ((ph & last_row) != 0) {
+        ++distance;
+      } else if ((mh & last_row) != 0) {
+        --distance;
+      }
+      ph = (ph << 1) | 1;
+      mh <<= 1;
+      pv = mh | ~(xv | ph);
+      mv = ph & xv;
+      // Each remaining column lowers the distance by one at most
+      if (distance > max_distance + (text.size() - j - 1)) {
+        return too_far;
       }
     }
+    return distance;
   }
 
-  return dp[s1.size()][s2.size()];
-}
+private:
+  // Bit i of m_peq[c] is set if the pattern has c at i
+  std::array<std::uint64_t, 256> m_peq{};
+  std::size_t m_size;
+};
 
-template <typename ValueType>
-std::string get_most_similar_string(const std::map<std::string, ValueType> &map,
-                                    const std::string &input) {
-  std::string most_similar{};
-  std::size_t min_distance = (std::numeric_limits<std::size_t>::max)();
+/*
+ * Levenshtein distance between s1 and s2, or max_distance + 1 if it is
+ * larger. When the shorter string fits in a LevenshteinPattern, the distance
+ * is computed with bit vectors. Longer strings keep two rows of the matrix,
+ * limited to a band of max_distance around the diagonal. Both stop as soon
+ * as the distance is known to exceed max_distance.
+ */
+inline std::size_t get_levenshtein_distance(std::string_view s1,
+                                            std::string_view s2,
+                                            std::size_t max_distance) {
+  if (s1.size() > s2.size()) {
+    std::swap(s1, s2);
+  }
+  if (s1.size() <= LevenshteinPattern::max_size) {
+    return LevenshteinPattern(s1).distance(s2, max_distance);
+  }
+  max_distance = std::min(max_distance, s2.size());
+  const auto too_far = max_distance + 1;
+  if (s2.size() - s1.size() > max_distance) {
+    return too_far;
+  }
 
-  for (const auto &entry : map) {
-    std::size_t distance = get_levenshtein_distance(entry.first, input);
-    if (distance < min_distance) {
-      min_distance = distance;
-      most_similar = entry.first;
-    }
+  // Rows follow s2, columns s1; cells out of the band are too far
+  std::vector<std::size_t> previous(s1.size() + 1, too_far);
+  std::vector<std::size_t> current(s1.size() + 1, too_far);
+  for (std::size_t j = 0; j <= std::min(max_distance, s1.size()); ++j) {
+    previous[j] = j;
   }
+  for (std::size_t i = 1; i <= s2.size(); ++i) {
+    const auto first = i > max_distance ? i - max_distance : 1;
+    const auto last = std::min(s1.size(), i + max_distance);
+    current[first - 1] = first == 1 ? std::min(i, too_far) : too_far;
+    auto row_min = current[first - 1];
+    for (std::size_t j = first; j <= last; ++j) {
+      const std::size_t cost = s2[i - 1] == s1[j - 1] ? 0 : 1;
+      current[j] = std::min({previous[j - 1] + cost, previous[j] + 1,
+                             current[j - 1] + 1, too_far});
+      row_min = std::min(row_min, current[j]);
+    }
+    if (last < s1.size()) {
+      current[last + 1] = too_far;
+    }
+    if (row_min > max_distance) {
+      return too_far;
+    }
+    std::swap(previous, current);
+  }
+  return previous[s1.size()];
+}
 
-  return most_similar;
+inline std::size_t get_levenshtein_distance(std::string_view s1,
+                                            std::string_view s2) {
+  return get_levenshtein_distance(s1, s2, std::max(s1.size(), s2.size()));
 }
 
-} // namespace details
+/*
+ * The names of the elements of range closest to input, closest first: at
+ * most count of them, each within max_distance edits. Names at the same
+ * distance are in the order of the range. name_of gives the name of an
+ * element. The distance to each name is only computed up to the distance
+ * of the farthest name kept so far.
+ */
+template <typename Range, typename NameOf>
+std::vector<std::string_view>
+get_most_similar_strings(const Range &range, NameOf &&name_of,
+                         std::string_view input, std::size_t max_distance,
+                         std::size_t count) {
+  std::vector<std::pair<std::size_t, std::string_view>> closest;
+  for (const auto &element : range) {
+    if (count == 0 ||
+        (closest.size() == count && closest.back().first == 0)) {
+      break;
+    }
+    const std::string_view name = name_of(element);
+    const auto bound =
+        closest.size() == count ? closest.back().first - 1 : max_distance;
+    const auto distance = get_levenshtein_distance(name, input, bound);
+    if (distance > bound) {
+      continue;
+    }
+    closest.insert(std::upper_bound(closest.begin(), closest.end(), distance,
+                                    [](std::size_t d, const auto &entry) {
+                                      return d < entry.first;
+                                    }),
+                   {distance, name});
+    if (closest.size() > count) {
+      closest.pop_back();
+    }
+  }
+  std::vector<std::string_view> names;
+  names.reserve(closest.size());
+  for (const auto &entry : closest) {
+    names.push_back(entry.second);
+  }
+  return names;
+}
 
-enum class nargs_pattern { optional, any, at_least_one };
+/*
+ * A read-only map from names to values, stored as a flat open addressing
+ * hash table. Entries keep the hash of their name so that a lookup only
+ * compares names when the hashes match. Lookups take a string_view and never
+ * allocate.
+ */
+template <typename Value> class FlatNameIndex {
+public:
+  struct Entry {
+    std::uint64_t hash;
+    std::string_view name;
+    Value value;
+  };
+
+  explicit FlatNameIndex(const allocator<std::byte> &alloc = {})
+      : m_entries(alloc), m_slots(alloc) {}
+
+  // Build the index from the (name, value) pairs of a map. The names must
+  // outlive the index.
+  template <typename Map> void assign(const Map &map) {
+    m_entries.clear();
+    m_entries.reserve(map.size());
+    std::size_t capacity = 8;
+    while (capacity < 2 * map.size()) {
+      capacity *= 2;
+    }
+    m_slots.assign(capacity, 0);
+    for (const auto &[name, value] : map) {
+      m_entries.push_back(Entry{hash_of(name), name, value});
+      auto slot = m_entries.back().hash & (capacity - 1);
+      while (m_slots[slot] != 0) {
+        slot = (slot + 1) & (capacity - 1);
+      }
+      m_slots[slot] = m_entries.size();
+    }
+  }
+
+  const Entry *find(std::string_view name) const {
+    if (m_slots.empty()) {
+      return nullptr;
+    }
+    const auto hash = hash_of(name);
+    const auto mask = m_slots.size() - 1;
+    for (auto slot = hash & mask; m_slots[slot] != 0;
+         slot = (slot + 1) & mask) {
+      const auto &entry = m_entries[m_slots[slot] - 1];
+      if (entry.hash == hash && entry.name == name) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::size_t size() const { return m_entries.size(); }
+
+  void clear() {
+    m_entries.clear();
+    m_slots.clear();
+  }
+
+private:
+  // FNV-1a
+  static std::uint64_t hash_of(std::string_view name) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (auto c : name) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  vector<Entry> m_entries;
+  vector<std::size_t> m_slots; // index + 1 in m_entries, 0 if free
+};
+
+/*
+ * The names closest to a string among many, for suggestions. Names are
+ * sorted by length and keep the set of their characters as a 64-bit
+ * signature. As an edit adds or removes at most one character on each side,
+ * a name is only compared to the input when neither the difference of their
+ * lengths nor half the characters they do not share exceed the distance.
+ */
+class SimilarityIndex {
+public:
+  explicit SimilarityIndex(const allocator<std::byte> &alloc = {})
+      : m_entries(alloc) {}
+
+  // Build the index from a range of names, which must outlive the index
+  template <typename Range> void assign(const Range &names) {
+    m_entries.clear();
+    for (const auto &name : names) {
+      const std::string_view view(name);
+      m_entries.push_back(Entry{view, signature_of(view), m_entries.size()});
+    }
+    std::sort(m_entries.begin(), m_entries.end(),
+              [](const Entry &a, const Entry &b) {
+                return a.name.size() != b.name.size()
+                           ? a.name.size() < b.name.size()
+                           : a.position < b.position;
+              });
+  }
+
+  // Like get_most_similar_strings over the names in the order they were
+  // given
+  std::vector<std::string_view> find(std::string_view input,
+                                     std::size_t max_distance,
+                                     std::size_t count) const {
+    std::vector<std::pair<std::size_t, const Entry *>> closest;
+    if (count == 0) {
+      return {};
+    }
+    std::optional<LevenshteinPattern> pattern;
+    if (input.size() <= LevenshteinPattern::max_size) {
+      pattern.emplace(input);
+    }
+    const auto signature = signature_of(input);
+    // Names are visited from the length of the input outwards, so that the
+    // distance to beat shrinks early: up goes to longer names, down to
+    // shorter ones
+    auto up = std::lower_bound(m_entries.begin(), m_entries.end(),
+                               input.size(),
+                               [](const Entry &entry, std::size_t size) {
+                                 return entry.name.size() < size;
+                               });
+    auto down = up;
+    constexpr auto none = (std::numeric_limits<std::size_t>::max)();
+    while (up != m_entries.end() || down != m_entries.begin()) {
+      // Once count names are kept, a name must be at most as far as the
+      // farthest of them to replace it, which it does if given before it
+      const auto bound =
+          closest.size() == count ? closest.back().first : max_distance;
+      const auto longer =
+          up != m_entries.end() ? up->name.size() - input.size() : none;
+      const auto shorter = down != m_entries.begin()
+                               ? input.size() - std::prev(down)->name.size()
+                               : none;
+      if (std::min(longer, shorter) > bound) {
+        break;
+      }
+      const auto it = longer <= shorter ? up++ : --down;
+      if ((popcount(signature ^ it->signature) + 1) / 2 > bound) {
+        continue;
+      }
+      const auto distance =
+          pattern ? pattern->distance(it->name, bound)
+                  : get_levenshtein_distance(it->name, input, bound);
+      if (distance > bound) {
+        continue;
+      }
+      const std::pair<std::size_t, const Entry *> candidate{distance, &*it};
+      closest.insert(std::upper_bound(closest.begin(), closest.end(),
+                                      candidate,
+                                      [](const auto &a, const auto &b) {
+                                        return a.first != b.first
+                                                   ? a.first < b.first
+                                                   : a.second->position <
+                                                         b.second->position;
+                                      }),
+                     candidate);
+      if (closest.size() > count) {
+        closest.pop_back();
+      }
+    }
+    std::vector<std::string_view> names;
+    names.reserve(closest.size());
+    for (const auto &entry : closest) {
+      names.push_back(entry.second->name);
+    }
+    return names;
+  }
+
+  std::size_t size() const { return m_entries.size(); }
+
+  void clear() { m_entries.clear(); }
+
+private:
+  struct Entry {
+    std::string_view name;
+    std::uint64_t signature;
+    std::size_t position;
+  };
+
+  // Bit c % 64 is set for each character c of name
+  static std::uint64_t signature_of(std::string_view name) {
+    std::uint64_t signature = 0;
+    for (auto c : name) {
+      signature |= std::uint64_t{1} << (static_cast<unsigned char>(c) % 64);
+    }
+    return signature;
+  }
+
+  static std::size_t popcount(std::uint64_t bits) {
+    std::size_t count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+      ++count;
+    }
+    return count;
+  }
+
+  vector<Entry> m_entries;
+};
+
+// The largest number of edits for a name to be suggested in place of input
+inline std::size_t max_typo_distance(std::string_view input) {
+  return input.size() / 3;
+}
+
+inline std::string unknown_argument_message(std::string_view token,
+                                            std::string_view similar) {
+  auto message = "Unknown argument: " + std::string(token);
+  if (!similar.empty()) {
+    message += ", did you mean '" + std::string(similar) + "'";
+  }
+  return message;
+}
+
+/*
+ * The values allowed for an argument, in the order they were given. Once
+ * they are all known, freeze() indexes them in a FlatNameIndex and builds the
+ * list shown in error messages, so that checking a value does not depend on
+ * the number of choices. Until then, values are searched linearly.
+ */
+class ChoiceSet {
+public:
+  ChoiceSet() = default;
+  ChoiceSet(const ChoiceSet &other) : m_choices(other.m_choices) {
+    if (other.is_frozen()) {
+      freeze();
+    }
+  }
+  ChoiceSet(ChoiceSet &&other) noexcept = default;
+  ChoiceSet &operator=(const ChoiceSet &other) {
+    ChoiceSet copy(other);
+    return *this = std::move(copy);
+  }
+  ChoiceSet &operator=(ChoiceSet &&other) = default;
+  ~ChoiceSet() = default;
+
+  void add(std::string choice) {
+    m_choices.push_back(std::move(choice));
+    m_index.clear();
+    m_similar.clear();
+    m_csv.clear();
+  }
+
+  void freeze() {
+    std::vector<std::pair<std::string_view, std::size_t>> entries;
+    entries.reserve(m_choices.size());
+    for (std::size_t i = 0; i < m_choices.size(); ++i) {
+      entries.emplace_back(m_choices[i], i);
+    }
+    m_index.assign(entries);
+    m_similar.assign(m_choices);
+    m_csv = join(m_choices.begin(), m_choices.end(), ", ");
+  }
+
+  bool contains(std::string_view value) const {
+    if (is_frozen()) {
+      return m_index.find(value) != nullptr;
+    }
+    return std::find(m_choices.begin(), m_choices.end(), value) !=
+           m_choices.end();
+  }
+
+  // The choice closest to a rejected value, or an empty string if none is
+  // close enough to be a likely typo
+  std::string_view similar(std::string_view value) const {
+    const auto names =
+        is_frozen() ? m_similar.find(value, max_typo_distance(value), 1)
+                    : get_most_similar_strings(
+                          m_choices,
+                          [](const std::string &choice) {
+                            return std::string_view(choice);
+                          },
+                          value, max_typo_distance(value), 1);
+    return names.empty() ? std::string_view{} : names.front();
+  }
+
+  const std::vector<std::string> &values() const { return m_choices; }
+
+  // The choices separated by ", "
+  std::string csv() const {
+    return is_frozen() ? m_csv
+                       : join(m_choices.begin(), m_choices.end(), ", ");
+  }
+
+private:
+  bool is_frozen() const {
+    return !m_choices.empty() && m_index.size() == m_choices.size();
+  }
+
+  std::vector<std::string> m_choices;
+  FlatNameIndex<std::size_t> m_index;
+  SimilarityIndex m_similar;
+  std::string m_csv;
+};
+
+// Number of values an argument takes
+class NArgsRange {
+  std::size_t m_min;
+  std::size_t m_max;
+
+public:
+  constexpr NArgsRange(std::size_t minimum, std::size_t maximum)
+      : m_min(minimum), m_max(maximum) {
+    if (minimum > maximum) {
+      throw std::logic_error("Range of number of arguments is invalid");
+    }
+  }
+
+  static constexpr NArgsRange of(nargs_pattern pattern) {
+    switch (pattern) {
+    case nargs_pattern::optional:
+      return {0, 1};
+    case nargs_pattern::any:
+      return {0, (std::numeric_limits<std::size_t>::max)()};
+    case nargs_pattern::at_least_one:
+      return {1, (std::numeric_limits<std::size_t>::max)()};
+    }
+    return {1, 1};
+  }
+
+  constexpr bool contains(std::size_t value) const {
+    return value >= m_min && value <= m_max;
+  }
+
+  constexpr bool is_exact() const { return m_min == m_max; }
+
+  constexpr bool is_right_bounded() const {
+    return m_max < (std::numeric_limits<std::size_t>::max)();
+  }
+
+  constexpr std::size_t get_min() const { return m_min; }
+
+  constexpr std::size_t get_max() const { return m_max; }
+
+  // Append the help message to out
+  void append_help(std::string &out) const {
+    if (m_min == m_max) {
+      if (m_min != 0 && m_min != 1) {
+        out += "[nargs: ";
+        out += std::to_string(m_min);
+        out += "] ";
+      }
+    } else {
+      if (m_max == (std::numeric_limits<std::size_t>::max)()) {
+        out += "[nargs: ";
+        out += std::to_string(m_min);
+        out += " or more] ";
+      } else {
+        out += "[nargs=";
+        out += std::to_string(m_min);
+        out += "..";
+        out += std::to_string(m_max);
+        out += "] ";
+      }
+    }
+  }
+
+  // Print help message
+  friend auto operator<<(std::ostream &stream, const NArgsRange &range)
+      -> std::ostream & {
+    std::string text;
+    range.append_help(text);
+    return stream << text;
+  }
+
+  constexpr bool operator==(const NArgsRange &rhs) const {
+    return rhs.m_min == m_min && rhs.m_max == m_max;
+  }
+
+  constexpr bool operator!=(const NArgsRange &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+// A set of characters, tested with one lookup instead of a search
+class CharSet {
+public:
+  explicit CharSet(std::string_view chars = {}) {
+    for (auto c : chars) {
+      m_contains[static_cast<unsigned char>(c)] = true;
+    }
+  }
+
+  bool contains(char c) const {
+    return m_contains[static_cast<unsigned char>(c)];
+  }
+
+private:
+  std::array<bool, 256> m_contains{};
+};
+
+// What a command-line token looks like, found once per parse
+enum class token_kind : unsigned char {
+  value,           // e.g. "file", "-" or ""
+  negative_number, // a prefix char then a decimal literal, e.g. "-1.5"
+  short_option,    // a prefix char then a name, e.g. "-v" or "-abc"
+  long_option,     // two prefix chars then a name, e.g. "--verbose"
+};
+
+inline bool is_value(token_kind kind) {
+  return kind == token_kind::value || kind == token_kind::negative_number;
+}
+
+// Text of help given as a std::string, which is kept, or as a StaticText,
+// of which only the view is kept
+class Text {
+public:
+  Text() = default;
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Text(std::string text) : m_owned(std::move(text)), m_view(m_owned) {}
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Text(StaticText text) : m_view(text.view) {}
+  Text(const Text &other) : m_owned(other.m_owned), m_view(other.m_view) {
+    if (!m_owned.empty()) {
+      m_view = m_owned;
+    }
+  }
+  Text(Text &&other) noexcept : Text() { *this = std::move(other); }
+  Text &operator=(const Text &other) {
+    Text copy(other);
+    return *this = std::move(copy);
+  }
+  Text &operator=(Text &&other) noexcept {
+    const bool owned = !other.m_owned.empty();
+    m_owned = std::move(other.m_owned);
+    m_view = owned ? std::string_view(m_owned) : other.m_view;
+    other.m_view = {};
+    return *this;
+  }
+  ~Text() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  operator std::string_view() const { return m_view; }
+  std::string_view view() const { return m_view; }
+  bool empty() const { return m_view.empty(); }
+  std::size_t size() const { return m_view.size(); }
+
+private:
+  std::string m_owned;
+  std::string_view m_view;
+};
+
+} // namespace details
 
 enum class default_arguments : unsigned int {
   none = 0,
@@ -594,41 +1701,220 @@ inline default_arguments operator&(const default_arguments &a,
       static_cast<std::underlying_type<default_arguments>::type>(b));
 }
 
+class Argument;
+
 class ArgumentParser;
 
+class ParseResult;
+
+template <typename T> class ArgHandle;
+
+/* Why try_parse() rejected a command line, or try_get() could not read
+ * a value, with the message of each error.
+ */
+enum class parse_errc {
+  unknown_argument = 1,   // Unknown argument: TOKEN
+  unknown_subcommand,     // Failed to parse 'TOKEN', did you mean 'COMMAND'
+  unexpected_positional,  // Zero positional arguments expected
+  too_many_positionals,   // Maximum number of positional arguments exceeded
+  duplicate_argument,     // Duplicate argument NAME
+  too_few_values,         // Too few arguments for 'NAME'.
+  missing_positional,     // Missing NAME
+  wrong_number_of_values, // NAME: N argument(s) expected. M provided.
+  invalid_choice,         // Invalid argument "TOKEN" - allowed options: {...}
+  invalid_value,          // the message of the converter
+  value_out_of_range,     // the message of the converter
+  required_argument,      // NAME: required.
+  missing_value,          // NAME: no value provided.
+  mutually_exclusive,     // Argument 'NAME' not allowed with 'NAME'
+  required_group,         // One of the arguments 'NAME' or 'NAME' is required
+  invalid_default_value,  // Invalid default value VALUE - allowed options: ...
+  no_such_argument,       // No such argument: NAME
+  no_value,               // No value provided for 'NAME'.
+  wrong_type,             // Wrong type for 'NAME'.
+};
+
+/* An error found by try_parse() or try_get(). The message is only built
+ * when asked for, and is the what() of the exception parse_args() or get()
+ * throw for the same error. It refers to the command line and to the parser,
+ * or to the name given to try_get(), so it must not outlive them.
+ */
+class ParseError {
+  friend class Argument;
+  friend class ArgumentParser;
+  friend class ParseResult;
+
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  parse_errc code() const noexcept { return m_code; }
+
+  // Position of the offending token in the command line, npos if the error
+  // is not about one token, e.g. a missing required argument
+  std::size_t token_index() const noexcept { return m_token_index; }
+
+  std::string_view token() const noexcept { return m_token; }
+
+  // The argument in error, nullptr if there is none, e.g. for an unknown one
+  const Argument *argument() const noexcept { return m_argument; }
+
+  std::string message() const;
+
+private:
+  ParseError() = default;
+
+  explicit ParseError(parse_errc code, const Argument *argument = nullptr,
+                      std::string_view name = {}, std::string_view token = {})
+      : m_code(code), m_token(token), m_argument(argument), m_name(name) {}
+
+  // Throws the exception parse_args() throws for this error
+  [[noreturn]] void raise() const;
+
+  parse_errc m_code{};
+  std::string_view m_token;
+  std::size_t m_token_index = npos;
+  const Argument *m_argument = nullptr;
+  // The name the argument was used with
+  std::string_view m_name;
+  // The other argument of a mutually exclusive pair, or the one suggested
+  const Argument *m_other = nullptr;
+  const ArgumentParser *m_parser = nullptr;
+  std::size_t m_group = 0;
+  std::size_t m_count = 0;
+  // Converts m_token, throwing the error of the converter
+  void (*m_convert)(std::string_view) = nullptr;
+  // Message of an exception thrown by an action
+  std::string m_message;
+};
+
+/* Either a value or the ParseError that prevented it, returned by
+ * try_parse() and try_get().
+ */
+template <typename T> class Expected {
+public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Expected(T value) : m_value(std::in_place_index<0>, std::move(value)) {}
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Expected(ParseError error)
+      : m_value(std::in_place_index<1>, std::move(error)) {}
+
+  bool has_value() const noexcept { return m_value.index() == 0; }
+
+  explicit operator bool() const noexcept { return has_value(); }
+
+  // @pre has_value()
+  T &value() & { return *std::get_if<0>(&m_value); }
+  const T &value() const & { return *std::get_if<0>(&m_value); }
+  T &&value() && { return std::move(*std::get_if<0>(&m_value)); }
+
+  T &operator*() & { return value(); }
+  const T &operator*() const & { return value(); }
+  T *operator->() { return &value(); }
+  const T *operator->() const { return &value(); }
+
+  // @pre !has_value()
+  const ParseError &error() const { return *std::get_if<1>(&m_value); }
+
+private:
+  std::variant<T, ParseError> m_value;
+};
+
 class Argument {
   friend class ArgumentParser;
-  friend auto operator<<(std::ostream &stream, const ArgumentParser &parser)
-      -> std::ostream &;
+  friend class ParseResult;
+  friend class ParseError;
+  template <typename T> friend class ArgHandle;
+
+  // The value which failed to convert, with the function to throw its error
+  struct ConversionFailure {
+    const std::string_view *value = nullptr;
+    std::errc error{};
+    void (*convert)(std::string_view) = nullptr;
+  };
+
+public:
+  /* Values of an argument of known type, see type<T>(), stored contiguously
+   * instead of one std::any per value.
+   */
+  struct TypedValues {
+    virtual ~TypedValues() = default;
+    virtual std::unique_ptr<TypedValues> clone() const = 0;
+    virtual std::size_t size() const = 0;
+  };
+
+  template <typename T> struct TypedValuesOf final : TypedValues {
+    std::vector<T> values;
+
+    std::unique_ptr<TypedValues> clone() const override {
+      return std::make_unique<TypedValuesOf>(*this);
+    }
+
+    std::size_t size() const override { return values.size(); }
+  };
+
+  /* Values collected for an argument while parsing. Kept apart from the
+   * definition of the argument so that a parser can be reused.
+   */
+  struct State {
+    details::vector<std::any> values;
+    std::unique_ptr<TypedValues> typed_values;
+    std::string_view used_name;
+    bool is_used = false;
+
+    State() = default;
+    explicit State(const details::allocator<std::any> &alloc)
+        : values(alloc) {}
+    State(const State &other)
+        : values(other.values),
+          typed_values(other.typed_values ? other.typed_values->clone()
+                                          : nullptr),
+          used_name(other.used_name), is_used(other.is_used) {}
+    State(State &&other) noexcept = default;
+    State &operator=(const State &other) {
+      State copy(other);
+      return *this = std::move(copy);
+    }
+    State &operator=(State &&other) = default;
+    ~State() = default;
+
+    std::size_t size() const {
+      return typed_values ? typed_values->size() : values.size();
+    }
+  };
 
-  template <std::size_t N, std::size_t... I>
+  // The names are given as a span, so that one constructor serves any count
   explicit Argument(std::string_view prefix_chars,
-                    std::array<std::string_view, N> &&a,
-                    std::index_sequence<I...> /*unused*/)
-      : m_accepts_optional_like_value(false),
-        m_is_optional((is_optional(a[I], prefix_chars) || ...)),
-        m_is_required(false), m_is_repeatable(false), m_is_used(false),
-        m_is_hidden(false), m_prefix_chars(prefix_chars) {
-    ((void)m_names.emplace_back(a[I]), ...);
-    std::sort(
-        m_names.begin(), m_names.end(), [](const auto &lhs, const auto &rhs) {
-          return lhs.size() == rhs.size() ? lhs < rhs : lhs.size() < rhs.size();
-        });
-  }
+                    const std::string_view *names, std::size_t count);
 
-public:
   template <std::size_t N>
   explicit Argument(std::string_view prefix_chars,
                     std::array<std::string_view, N> &&a)
-      : Argument(prefix_chars, std::move(a), std::make_index_sequence<N>{}) {}
+      : Argument(prefix_chars, a.data(), N) {}
 
   Argument &help(std::string help_text) {
     m_help = std::move(help_text);
+    changed_help();
+    return *this;
+  }
+
+  // Keeps a view of the text instead of a copy
+  Argument &help(StaticText help_text) {
+    m_help = help_text;
+    changed_help();
     return *this;
   }
 
   Argument &metavar(std::string metavar) {
     m_metavar = std::move(metavar);
+    changed_help();
+    return *this;
+  }
+
+  // Keeps a view of the text instead of a copy
+  Argument &metavar(StaticText metavar) {
+    m_metavar = metavar;
+    changed_help();
     return *this;
   }
 
@@ -643,6 +1929,7 @@ public:
     }
 
     m_default_value = std::forward<T>(value);
+    changed_help();
     return *this;
   }
 
@@ -652,12 +1939,14 @@ public:
 
   Argument &required() {
     m_is_required = true;
+    changed_help();
     return *this;
   }
 
   Argument &implicit_value(std::any value) {
     m_implicit_value = std::move(value);
     m_num_args_range = NArgsRange{0, 0};
+    changed_help();
     return *this;
   }
 
@@ -675,18 +1964,16 @@ public:
   auto action(F &&callable, Args &&... bound_args)
       -> std::enable_if_t<std::is_invocable_v<F, Args..., std::string const>,
                           Argument &> {
-    using action_type = std::conditional_t<
-        std::is_void_v<std::invoke_result_t<F, Args..., std::string const>>,
-        void_action, valued_action>;
     if constexpr (sizeof...(Args) == 0) {
-      m_actions.emplace_back<action_type>(std::forward<F>(callable));
+      add_action([f = std::forward<F>(callable)](std::string_view opt) mutable {
+        return std::invoke(f, std::string(opt));
+      });
     } else {
-      m_actions.emplace_back<action_type>(
-          [f = std::forward<F>(callable),
-           tup = std::make_tuple(std::forward<Args>(bound_args)...)](
-              std::string const &opt) mutable {
-            return details::apply_plus_one(f, tup, opt);
-          });
+      add_action([f = std::forward<F>(callable),
+                  tup = std::make_tuple(std::forward<Args>(bound_args)...)](
+                     std::string_view opt) mutable {
+        return details::apply_plus_one(f, tup, std::string(opt));
+      });
     }
     return *this;
   }
@@ -698,7 +1985,7 @@ public:
     if (m_default_value.has_value()) {
       var = std::any_cast<bool>(m_default_value);
     }
-    action([&var](const auto & /*unused*/) {
+    add_action([&var](std::string_view /*unused*/) {
       var = true;
       return var;
     });
@@ -710,7 +1997,7 @@ public:
     if (m_default_value.has_value()) {
       var = std::any_cast<T>(m_default_value);
     }
-    action([&var](const auto &s) {
+    add_action([&var](std::string_view s) {
       var = details::parse_number<T, details::radix_10>()(s);
       return var;
     });
@@ -722,8 +2009,9 @@ public:
     if (m_default_value.has_value()) {
       var = std::any_cast<T>(m_default_value);
     }
-    action([&var](const auto &s) {
-      var = details::parse_number<T, details::chars_format::general>()(s);
+    add_action([&var](std::string_view s) {
+      var = convert<T, details::parse_number<T, details::chars_format::general>>(
+          s);
       return var;
     });
     return *this;
@@ -733,7 +2021,7 @@ public:
     if (m_default_value.has_value()) {
       var = std::any_cast<std::string>(m_default_value);
     }
-    action([&var](const std::string &s) {
+    add_action([&var](std::string_view s) {
       var = s;
       return var;
     });
@@ -744,149 +2032,101 @@ public:
     if (m_default_value.has_value()) {
       var = std::any_cast<std::filesystem::path>(m_default_value);
     }
-    action([&var](const std::string &s) { var = s; });
-    return *this;
-  }
-
-  auto &store_into(std::vector<std::string> &var) {
-    if (m_default_value.has_value()) {
-      var = std::any_cast<std::vector<std::string>>(m_default_value);
-    }
-    action([this, &var](const std::string &s) {
-      if (!m_is_used) {
-        var.clear();
-      }
-      m_is_used = true;
-      var.push_back(s);
-      return var;
-    });
-    return *this;
-  }
-
-  auto &store_into(std::vector<int> &var) {
-    if (m_default_value.has_value()) {
-      var = std::any_cast<std::vector<int>>(m_default_value);
-    }
-    action([this, &var](const std::string &s) {
-      if (!m_is_used) {
-        var.clear();
-      }
-      m_is_used = true;
-      var.push_back(details::parse_number<int, details::radix_10>()(s));
-      return var;
-    });
+    add_action([&var](std::string_view s) { var = s; });
     return *this;
   }
 
-  auto &store_into(std::set<std::string> &var) {
+  /* Store the values into any container, converting them to its value_type
+   * like type<T>() does. The values are added to the container directly as
+   * they are parsed; the container is cleared on the first value. Each call
+   * adds a container, so that the values may be stored into several.
+   */
+  template <typename Container,
+            std::enable_if_t<details::IsContainer<Container>> * = nullptr>
+  auto &store_into(Container &var) {
+    using value_type = typename Container::value_type;
     if (m_default_value.has_value()) {
-      var = std::any_cast<std::set<std::string>>(m_default_value);
-    }
-    action([this, &var](const std::string &s) {
-      if (!m_is_used) {
+      var = std::any_cast<Container>(m_default_value);
+    }
+    m_store_actions.emplace_back([&var](State &state,
+                                        const std::string_view *first,
+                                        const std::string_view *last,
+                                        ConversionFailure &failure) {
+      using Converter = details::default_converter<value_type>;
+      if (!state.is_used) {
         var.clear();
       }
-      m_is_used = true;
-      var.insert(s);
-      return var;
-    });
-    return *this;
-  }
-
-  auto &store_into(std::set<int> &var) {
-    if (m_default_value.has_value()) {
-      var = std::any_cast<std::set<int>>(m_default_value);
-    }
-    action([this, &var](const std::string &s) {
-      if (!m_is_used) {
-        var.clear();
+      if constexpr (std::is_same_v<Container, std::vector<value_type>>) {
+        return append_values<value_type, Converter>(var, first, last,
+                                                    failure);
+      } else {
+        for (; first != last; ++first) {
+          value_type value{};
+          if (auto error = try_convert<value_type, Converter>(*first, value);
+              error != std::errc{}) {
+            failure = {first, error, &throw_conversion_error<value_type, Converter>};
+            return false;
+          }
+          if constexpr (details::HasPushBack<Container>) {
+            var.push_back(std::move(value));
+          } else {
+            var.insert(std::move(value));
+          }
+        }
+        return true;
       }
-      m_is_used = true;
-      var.insert(details::parse_number<int, details::radix_10>()(s));
-      return var;
     });
     return *this;
   }
 
   auto &append() {
     m_is_repeatable = true;
+    changed_help();
     return *this;
   }
 
+  /* Get a handle to read the value of this argument as a T after parsing,
+   * without looking the argument up by name.
+   * @throws std::bad_any_cast if the argument is stored with type<U>() or
+   * scan<>() as another type than T, or than the elements of T
+   */
+  template <typename T> ArgHandle<T> handle() const {
+    return ArgHandle<T>(*this);
+  }
+
   // Cause the argument to be invisible in usage and help
   auto &hidden() {
     m_is_hidden = true;
+    changed_help();
     return *this;
   }
 
-  template <char Shape, typename T>
-  auto scan() -> std::enable_if_t<std::is_arithmetic_v<T>, Argument &> {
-    static_assert(!(std::is_const_v<T> || std::is_volatile_v<T>),
-                  "T should not be cv-qualified");
-    auto is_one_of = [](char c, auto... x) constexpr {
-      return ((c == x) || ...);
-    };
-
-    if constexpr (is_one_of(Shape, 'd') && details::standard_integer<T>) {
-      action(details::parse_number<T, details::radix_10>());
-    } else if constexpr (is_one_of(Shape, 'i') &&
-                         details::standard_integer<T>) {
-      action(details::parse_number<T>());
-    } else if constexpr (is_one_of(Shape, 'u') &&
-                         details::standard_unsigned_integer<T>) {
-      action(details::parse_number<T, details::radix_10>());
-    } else if constexpr (is_one_of(Shape, 'b') &&
-                         details::standard_unsigned_integer<T>) {
-      action(details::parse_number<T, details::radix_2>());
-    } else if constexpr (is_one_of(Shape, 'o') &&
-                         details::standard_unsigned_integer<T>) {
-      action(details::parse_number<T, details::radix_8>());
-    } else if constexpr (is_one_of(Shape, 'x', 'X') &&
-                         details::standard_unsigned_integer<T>) {
-      action(details::parse_number<T, details::radix_16>());
-    } else if constexpr (is_one_of(Shape, 'a', 'A') &&
-                         std::is_floating_point_v<T>) {
-      action(details::parse_number<T, details::chars_format::hex>());
-    } else if constexpr (is_one_of(Shape, 'e', 'E') &&
-                         std::is_floating_point_v<T>) {
-      action(details::parse_number<T, details::chars_format::scientific>());
-    } else if constexpr (is_one_of(Shape, 'f', 'F') &&
-                         std::is_floating_point_v<T>) {
-      action(details::parse_number<T, details::chars_format::fixed>());
-    } else if constexpr (is_one_of(Shape, 'g', 'G') &&
-                         std::is_floating_point_v<T>) {
-      action(details::parse_number<T, details::chars_format::general>());
-    } else {
-      static_assert(alignof(T) == 0, "No scan specification for T");
-    }
+  /* Store the values of this argument as T, in one contiguous buffer per
+   * parse instead of one std::any per value. Integers are parsed as decimal
+   * numbers, floating point numbers in the general format, and any other T
+   * is constructed from the std::string. Use scan<>() for other formats.
+   * The values can be read back without copies with get_view<T>().
+   */
+  template <typename T> Argument &type();
 
-    return *this;
-  }
+  template <char Shape, typename T>
+  auto scan() -> std::enable_if_t<std::is_arithmetic_v<T>, Argument &>;
 
   Argument &nargs(std::size_t num_args) {
     m_num_args_range = NArgsRange{num_args, num_args};
+    changed_help();
     return *this;
   }
 
   Argument &nargs(std::size_t num_args_min, std::size_t num_args_max) {
     m_num_args_range = NArgsRange{num_args_min, num_args_max};
+    changed_help();
     return *this;
   }
 
   Argument &nargs(nargs_pattern pattern) {
-    switch (pattern) {
-    case nargs_pattern::optional:
-      m_num_args_range = NArgsRange{0, 1};
-      break;
-    case nargs_pattern::any:
-      m_num_args_range =
-          NArgsRange{0, (std::numeric_limits<std::size_t>::max)()};
-      break;
-    case nargs_pattern::at_least_one:
-      m_num_args_range =
-          NArgsRange{1, (std::numeric_limits<std::size_t>::max)()};
-      break;
-    }
+    m_num_args_range = NArgsRange::of(pattern);
+    changed_help();
     return *this;
   }
 
@@ -902,21 +2142,22 @@ public:
                       details::can_invoke_to_string<T>::value,
                   "Choice is not convertible to string_type");
     if (!m_choices.has_value()) {
-      m_choices = std::vector<std::string>{};
+      m_choices.emplace();
     }
 
     if constexpr (std::is_convertible_v<T, std::string_view>) {
-      m_choices.value().push_back(
-          std::string{std::string_view{std::forward<T>(choice)}});
+      m_choices->add(std::string{std::string_view{std::forward<T>(choice)}});
     } else if constexpr (details::can_invoke_to_string<T>::value) {
-      m_choices.value().push_back(std::to_string(std::forward<T>(choice)));
+      m_choices->add(std::to_string(std::forward<T>(choice)));
     }
   }
 
+  // Ends a call to choices(...): all the choices are known and indexed
   Argument &choices() {
     if (!m_choices.has_value()) {
       throw std::runtime_error("Zero choices provided");
     }
+    m_choices->freeze();
     return *this;
   }
 
@@ -927,64 +2168,48 @@ public:
     return *this;
   }
 
-  void find_default_value_in_choices_or_throw() const {
-
-    const auto &choices = m_choices.value();
-
-    if (m_default_value.has_value()) {
-      if (std::find(choices.begin(), choices.end(), m_default_value_str) ==
-          choices.end()) {
-        // provided arg not in list of allowed choices
-        // report error
-
-        std::string choices_as_csv =
-            std::accumulate(choices.begin(), choices.end(), std::string(),
-                            [](const std::string &a, const std::string &b) {
-                              return a + (a.empty() ? "" : ", ") + b;
-                            });
-
-        throw std::runtime_error(
-            std::string{"Invalid default value "} + m_default_value_repr +
-            " - allowed options: {" + choices_as_csv + "}");
-      }
-    }
-  }
+  bool is_default_value_in_choices() const {
+    return !m_default_value.has_value() ||
+           (m_default_value_str.has_value() &&
+            m_choices->contains(*m_default_value_str));
+  }
 
   template <typename Iterator>
   bool is_value_in_choices(Iterator option_it) const {
-
-    const auto &choices = m_choices.value();
-
-    return (std::find(choices.begin(), choices.end(), *option_it) !=
-            choices.end());
+    return m_choices->contains(*option_it);
   }
 
+  /* The dry_run parameter can be set to true to avoid running the actions,
+   * and marking the argument as used. This may be used by a pre-processing
+   * step to do a first iteration over arguments.
+   */
   template <typename Iterator>
-  void throw_invalid_arguments_error(Iterator option_it) const {
-    const auto &choices = m_choices.value();
-    const std::string choices_as_csv = std::accumulate(
-        choices.begin(), choices.end(), std::string(),
-        [](const std::string &option_a, const std::string &option_b) {
-          return option_a + (option_a.empty() ? "" : ", ") + option_b;
+  Iterator consume(Iterator start, Iterator end,
+                   std::string_view used_name = {}, bool dry_run = false) {
+    const auto values_end =
+        std::find_if(start, end, [this](std::string_view token) {
+          return is_optional(token, m_prefix_chars);
         });
-
-    throw std::runtime_error(std::string{"Invalid argument "} +
-                             details::repr(*option_it) +
-                             " - allowed options: {" + choices_as_csv + "}");
+    return consume(start, end, values_end, m_state, used_name, dry_run);
   }
 
-  /* The dry_run parameter can be set to true to avoid running the actions,
-   * and setting m_is_used. This may be used by a pre-processing step to do
-   * a first iteration over arguments.
+  /* Same as above, but records the values into the given parse state
+   * instead of the one owned by this argument, so that a const Argument
+   * can be consumed concurrently against distinct states. values_end is the
+   * first optional-like token in [start, end), as the parser classified it.
+   * If error is given, an invalid value is reported there and end returned,
+   * instead of throwing an exception.
    */
   template <typename Iterator>
-  Iterator consume(Iterator start, Iterator end,
-                   std::string_view used_name = {}, bool dry_run = false) {
-    if (!m_is_repeatable && m_is_used) {
-      throw std::runtime_error(
-          std::string("Duplicate argument ").append(used_name));
+  Iterator consume(Iterator start, Iterator end, Iterator values_end,
+                   State &state, std::string_view used_name = {},
+                   bool dry_run = false, ParseError *error = nullptr) const {
+    if (!m_is_repeatable && state.is_used) {
+      report_error(error, ParseError(parse_errc::duplicate_argument, this,
+                                     used_name));
+      return end;
     }
-    m_used_name = used_name;
+    state.used_name = used_name;
 
     std::size_t passed_options = 0;
 
@@ -1004,7 +2229,9 @@ public:
           break;
         }
 
-        throw_invalid_arguments_error(it);
+        report_error(error, ParseError(parse_errc::invalid_choice, this,
+                                       used_name, *it));
+        return end;
       }
     }
 
@@ -1014,14 +2241,19 @@ public:
     std::size_t dist = 0;
     if (num_args_max == 0) {
       if (!dry_run) {
-        m_values.emplace_back(m_implicit_value);
-        for(auto &action: m_actions) {
-          std::visit([&](const auto &f) { f({}); }, action);
-        }
-        if(m_actions.empty()){
-          std::visit([&](const auto &f) { f({}); }, m_default_action);
+        state.values.emplace_back(m_implicit_value);
+        const auto run_actions = [&] {
+          for (auto &action : m_actions) {
+            std::visit([&](const auto &f) { f({}); }, action);
+          }
+          if (m_actions.empty()) {
+            std::visit([&](const auto &f) { f({}); }, m_default_action);
+          }
+        };
+        if (!run_reporting_errors(run_actions, error, std::string_view{})) {
+          return end;
         }
-        m_is_used = true;
+        state.is_used = true;
       }
       return start;
     }
@@ -1032,79 +2264,117 @@ public:
                                    num_args_max));
       }
       if (!m_accepts_optional_like_value) {
-        end = std::find_if(
-            start, end,
-            std::bind(is_optional, std::placeholders::_1, m_prefix_chars));
+        if (std::distance(start, values_end) < std::distance(start, end)) {
+          end = values_end;
+        }
         dist = static_cast<std::size_t>(std::distance(start, end));
         if (dist < num_args_min) {
-          throw std::runtime_error("Too few arguments for '" +
-                                   std::string(m_used_name) + "'.");
+          report_error(error, ParseError(parse_errc::too_few_values, this,
+                                         state.used_name));
+          return end;
         }
       }
       struct ActionApply {
-        void operator()(valued_action &f) {
-          std::transform(first, last, std::back_inserter(self.m_values), f);
+        void operator()(const valued_action &f) {
+          for (current = first; current != last; ++current) {
+            state.values.push_back(f(*current));
+          }
         }
 
-        void operator()(void_action &f) {
-          std::for_each(first, last, f);
-          if (!self.m_default_value.has_value()) {
+        void operator()(const void_action &f) {
+          for (current = first; current != last; ++current) {
+            f(*current);
+          }
+          if (!self.m_default_value.has_value() &&
+              self.m_typed_action == nullptr) {
             if (!self.m_accepts_optional_like_value) {
-              self.m_values.resize(
+              state.values.resize(
                   static_cast<std::size_t>(std::distance(first, last)));
             }
           }
         }
 
         Iterator first, last;
-        Argument &self;
+        Iterator &current;
+        const Argument &self;
+        State &state;
       };
       if (!dry_run) {
-        for(auto &action: m_actions) {
-          std::visit(ActionApply{start, end, *this}, action);
+        ConversionFailure failure;
+        const auto convert_values = [&](const std::string_view *first,
+                                        const std::string_view *last) {
+          if (m_typed_action != nullptr &&
+              !m_typed_action(state, first, last, failure)) {
+            return false;
+          }
+          if (m_store_actions.empty()) {
+            return true;
+          }
+          for (auto &store : m_store_actions) {
+            if (!store(state, first, last, failure)) {
+              return false;
+            }
+          }
+          // The containers are cleared on the first run of values only
+          state.is_used = true;
+          return true;
+        };
+        if ((m_typed_action != nullptr || !m_store_actions.empty()) &&
+            !for_each_run(start, end, convert_values)) {
+          ParseError conversion_error(
+              failure.error == std::errc::result_out_of_range
+                  ? parse_errc::value_out_of_range
+                  : parse_errc::invalid_value,
+              this, state.used_name, *failure.value);
+          conversion_error.m_convert = failure.convert;
+          report_error(error, std::move(conversion_error));
+          return end;
         }
-        if(m_actions.empty()){
-          std::visit(ActionApply{start, end, *this}, m_default_action);
+        auto current = start;
+        const auto run_actions = [&] {
+          for (auto &action : m_actions) {
+            std::visit(ActionApply{start, end, current, *this, state},
+                       action);
+          }
+          if (m_actions.empty() && m_typed_action == nullptr) {
+            if (!m_store_actions.empty()) {
+              // Count the values stored, as a void action does
+              if (!m_default_value.has_value() &&
+                  !m_accepts_optional_like_value) {
+                state.values.resize(
+                    static_cast<std::size_t>(std::distance(start, end)));
+              }
+            } else {
+              std::visit(ActionApply{start, end, current, *this, state},
+                         m_default_action);
+            }
+          }
+        };
+        if (!run_reporting_errors(run_actions, error, current)) {
+          return end;
         }
-        m_is_used = true;
+        state.is_used = true;
       }
       return end;
     }
     if (m_default_value.has_value()) {
       if (!dry_run) {
-        m_is_used = true;
+        state.is_used = true;
       }
       return start;
     }
-    throw std::runtime_error("Too few arguments for '" +
-                             std::string(m_used_name) + "'.");
+    report_error(error,
+                 ParseError(parse_errc::too_few_values, this, state.used_name));
+    return end;
   }
 
   /*
    * @throws std::runtime_error if argument values are not valid
    */
-  void validate() const {
-    if (m_is_optional) {
-      // TODO: check if an implicit value was programmed for this argument
-      if (!m_is_used && !m_default_value.has_value() && m_is_required) {
-        throw_required_arg_not_used_error();
-      }
-      if (m_is_used && m_is_required && m_values.empty()) {
-        throw_required_arg_no_value_provided_error();
-      }
-    } else {
-      if (!m_num_args_range.contains(m_values.size()) &&
-          !m_default_value.has_value()) {
-        throw_nargs_range_validation_error();
-      }
-    }
+  void validate() const { validate(m_state); }
 
-    if (m_choices.has_value()) {
-      // Make sure the default value (if provided)
-      // is in the list of choices
-      find_default_value_in_choices_or_throw();
-    }
-  }
+  // If error is given, an error is reported there instead of thrown
+  void validate(const State &state, ParseError *error = nullptr) const;
 
   std::string get_names_csv(char separator = ',') const {
     return std::accumulate(
@@ -1114,155 +2384,33 @@ public:
         });
   }
 
-  std::string get_usage_full() const {
-    std::stringstream usage;
+  std::string get_usage_full() const;
 
-    usage << get_names_csv('/');
-    const std::string metavar = !m_metavar.empty() ? m_metavar : "VAR";
-    if (m_num_args_range.get_max() > 0) {
-      usage << " " << metavar;
-      if (m_num_args_range.get_max() > 1) {
-        usage << "...";
-      }
-    }
-    return usage.str();
-  }
+  // Append the usage of the argument, e.g. "[--name VAR]", to out
+  void append_inline_usage(std::string &out) const;
 
   std::string get_inline_usage() const {
-    std::stringstream usage;
-    // Find the longest variant to show in the usage string
-    std::string longest_name = m_names.front();
-    for (const auto &s : m_names) {
-      if (s.size() > longest_name.size()) {
-        longest_name = s;
-      }
-    }
-    if (!m_is_required) {
-      usage << "[";
-    }
-    usage << longest_name;
-    const std::string metavar = !m_metavar.empty() ? m_metavar : "VAR";
-    if (m_num_args_range.get_max() > 0) {
-      usage << " " << metavar;
-      if (m_num_args_range.get_max() > 1 &&
-          m_metavar.find("> <") == std::string::npos) {
-        usage << "...";
-      }
-    }
-    if (!m_is_required) {
-      usage << "]";
-    }
-    if (m_is_repeatable) {
-      usage << "...";
-    }
-    return usage.str();
+    std::string usage;
+    append_inline_usage(usage);
+    return usage;
   }
 
-  std::size_t get_arguments_length() const {
-
-    std::size_t names_size = std::accumulate(
-        std::begin(m_names), std::end(m_names), std::size_t(0),
-        [](const auto &sum, const auto &s) { return sum + s.size(); });
-
-    if (is_positional(m_names.front(), m_prefix_chars)) {
-      // A set metavar means this replaces the names
-      if (!m_metavar.empty()) {
-        // Indent and metavar
-        return 2 + m_metavar.size();
-      }
+  std::size_t get_arguments_length() const;
 
-      // Indent and space-separated
-      return 2 + names_size + (m_names.size() - 1);
-    }
-    // Is an option - include both names _and_ metavar
-    // size = text + (", " between names)
-    std::size_t size = names_size + 2 * (m_names.size() - 1);
-    if (!m_metavar.empty() && m_num_args_range == NArgsRange{1, 1}) {
-      size += m_metavar.size() + 1;
-    }
-    return size + 2; // indent
-  }
+  /* Append the line of the help message for the argument to out, with the
+   * names padded to name_width so that the help texts line up.
+   */
+  void append_help(std::string &out, std::size_t name_width) const;
 
+  // Print the line of the help message, with the names padded to the width
+  // of the stream
   friend std::ostream &operator<<(std::ostream &stream,
                                   const Argument &argument) {
-    std::stringstream name_stream;
-    name_stream << "  "; // indent
-    if (argument.is_positional(argument.m_names.front(),
-                               argument.m_prefix_chars)) {
-      if (!argument.m_metavar.empty()) {
-        name_stream << argument.m_metavar;
-      } else {
-        name_stream << details::join(argument.m_names.begin(),
-                                     argument.m_names.end(), " ");
-      }
-    } else {
-      name_stream << details::join(argument.m_names.begin(),
-                                   argument.m_names.end(), ", ");
-      // If we have a metavar, and one narg - print the metavar
-      if (!argument.m_metavar.empty() &&
-          argument.m_num_args_range == NArgsRange{1, 1}) {
-        name_stream << " " << argument.m_metavar;
-      }
-      else if (!argument.m_metavar.empty() &&
-               argument.m_num_args_range.get_min() == argument.m_num_args_range.get_max() &&
-               argument.m_metavar.find("> <") != std::string::npos) {
-        name_stream << " " << argument.m_metavar;
-      }
-    }
-
-    // align multiline help message
-    auto stream_width = stream.width();
-    auto name_padding = std::string(name_stream.str().size(), ' ');
-    auto pos = std::string::size_type{};
-    auto prev = std::string::size_type{};
-    auto first_line = true;
-    auto hspace = "  "; // minimal space between name and help message
-    stream << name_stream.str();
-    std::string_view help_view(argument.m_help);
-    while ((pos = argument.m_help.find('\n', prev)) != std::string::npos) {
-      auto line = help_view.substr(prev, pos - prev + 1);
-      if (first_line) {
-        stream << hspace << line;
-        first_line = false;
-      } else {
-        stream.width(stream_width);
-        stream << name_padding << hspace << line;
-      }
-      prev += pos - prev + 1;
-    }
-    if (first_line) {
-      stream << hspace << argument.m_help;
-    } else {
-      auto leftover = help_view.substr(prev, argument.m_help.size() - prev);
-      if (!leftover.empty()) {
-        stream.width(stream_width);
-        stream << name_padding << hspace << leftover;
-      }
-    }
-
-    // print nargs spec
-    if (!argument.m_help.empty()) {
-      stream << " ";
-    }
-    stream << argument.m_num_args_range;
-
-    bool add_space = false;
-    if (argument.m_default_value.has_value() &&
-        argument.m_num_args_range != NArgsRange{0, 0}) {
-      stream << "[default: " << argument.m_default_value_repr << "]";
-      add_space = true;
-    } else if (argument.m_is_required) {
-      stream << "[required]";
-      add_space = true;
-    }
-    if (argument.m_is_repeatable) {
-      if (add_space) {
-        stream << " ";
-      }
-      stream << "[may be repeated]";
-    }
-    stream << "\n";
-    return stream;
+    std::string line;
+    argument.append_help(line, static_cast<std::size_t>(
+                                   std::max<std::streamsize>(stream.width(), 0)));
+    stream.width(0);
+    return stream << line;
   }
 
   template <typename T> bool operator!=(const T &rhs) const {
@@ -1294,103 +2442,64 @@ public:
    *    !'-' anything
    */
   static bool is_positional(std::string_view name,
-                            std::string_view prefix_chars) {
-    auto first = lookahead(name);
-
-    if (first == eof) {
-      return true;
-    }
-    if (prefix_chars.find(static_cast<char>(first)) !=
-                          std::string_view::npos) {
-      name.remove_prefix(1);
-      if (name.empty()) {
-        return true;
-      }
-      return is_decimal_literal(name);
-    }
-    return true;
-  }
+                            std::string_view prefix_chars);
 
 private:
-  class NArgsRange {
-    std::size_t m_min;
-    std::size_t m_max;
-
-  public:
-    NArgsRange(std::size_t minimum, std::size_t maximum)
-        : m_min(minimum), m_max(maximum) {
-      if (minimum > maximum) {
-        throw std::logic_error("Range of number of arguments is invalid");
-      }
-    }
+  using NArgsRange = details::NArgsRange;
 
-    bool contains(std::size_t value) const {
-      return value >= m_min && value <= m_max;
+  // Reports error to the caller if it asked for it, throws it otherwise
+  static void report_error(ParseError *sink, ParseError &&error) {
+    if (sink == nullptr) {
+      error.raise();
     }
+    *sink = std::move(error);
+  }
 
-    bool is_exact() const { return m_min == m_max; }
-
-    bool is_right_bounded() const {
-      return m_max < (std::numeric_limits<std::size_t>::max)();
+  /* Runs the actions, reporting the std::invalid_argument or std::range_error
+   * they throw for the value at current to error if it is given.
+   * @returns false if an error was reported
+   */
+  template <typename F, typename Iterator>
+  bool run_reporting_errors(F &&run_actions, ParseError *error,
+                            const Iterator &current) const {
+    if (error == nullptr) {
+      run_actions();
+      return true;
     }
-
-    std::size_t get_min() const { return m_min; }
-
-    std::size_t get_max() const { return m_max; }
-
-    // Print help message
-    friend auto operator<<(std::ostream &stream, const NArgsRange &range)
-        -> std::ostream & {
-      if (range.m_min == range.m_max) {
-        if (range.m_min != 0 && range.m_min != 1) {
-          stream << "[nargs: " << range.m_min << "] ";
-        }
-      } else {
-        if (range.m_max == (std::numeric_limits<std::size_t>::max)()) {
-          stream << "[nargs: " << range.m_min << " or more] ";
-        } else {
-          stream << "[nargs=" << range.m_min << ".." << range.m_max << "] ";
-        }
+    const auto report = [&](parse_errc code, const std::exception &e) {
+      *error = ParseError(code, this);
+      if constexpr (!std::is_same_v<Iterator, std::string_view>) {
+        error->m_token = *current;
       }
-      return stream;
-    }
-
-    bool operator==(const NArgsRange &rhs) const {
-      return rhs.m_min == m_min && rhs.m_max == m_max;
+      error->m_message = e.what();
+    };
+    try {
+      run_actions();
+      return true;
+    } catch (const std::invalid_argument &e) {
+      report(parse_errc::invalid_value, e);
+    } catch (const std::range_error &e) {
+      report(parse_errc::value_out_of_range, e);
     }
+    return false;
+  }
 
-    bool operator!=(const NArgsRange &rhs) const { return !(*this == rhs); }
-  };
+  std::string nargs_error_message(std::string_view used_name,
+                                  std::size_t provided) const;
 
-  void throw_nargs_range_validation_error() const {
-    std::stringstream stream;
-    if (!m_used_name.empty()) {
-      stream << m_used_name << ": ";
-    } else {
-      stream << m_names.front() << ": ";
-    }
-    if (m_num_args_range.is_exact()) {
-      stream << m_num_args_range.get_min();
-    } else if (m_num_args_range.is_right_bounded()) {
-      stream << m_num_args_range.get_min() << " to "
-             << m_num_args_range.get_max();
-    } else {
-      stream << m_num_args_range.get_min() << " or more";
+  std::string invalid_choice_message(std::string_view value) const {
+    auto message = std::string{"Invalid argument "} + details::repr(value) +
+                   " - allowed options: {" + m_choices->csv() + "}";
+    const auto similar = m_choices->similar(value);
+    if (!similar.empty()) {
+      message += ", did you mean " + details::repr(similar);
     }
-    stream << " argument(s) expected. " << m_values.size() << " provided.";
-    throw std::runtime_error(stream.str());
-  }
-
-  void throw_required_arg_not_used_error() const {
-    std::stringstream stream;
-    stream << m_names.front() << ": required.";
-    throw std::runtime_error(stream.str());
+    return message;
   }
 
-  void throw_required_arg_no_value_provided_error() const {
-    std::stringstream stream;
-    stream << m_used_name << ": no value provided.";
-    throw std::runtime_error(stream.str());
+  std::string invalid_default_value_message() const {
+    return std::string{"Invalid default value "} + m_default_value_repr +
+           " - allowed options: {" + m_choices->csv() + "}";
   }
 
   static constexpr int eof = std::char_traits<char>::eof();
@@ -1430,166 +2539,225 @@ private:
    * sign: one of
    *    '+' '-'
    */
-  static bool is_decimal_literal(std::string_view s) {
-    auto is_digit = [](auto c) constexpr {
-      switch (c) {
-      case '0':
-      case '1':
-      case '2':
-      case '3':
-      case '4':
-      case '5':
-      case '6':
-      case '7':
-      case '8':
-      case '9':
-        return true;
-      default:
-        return false;
-      }
-    };
+  static bool is_decimal_literal(std::string_view s);
 
-    // precondition: we have consumed or will consume at least one digit
-    auto consume_digits = [=](std::string_view sd) {
-      // NOLINTNEXTLINE(readability-qualified-auto)
-      auto it = std::find_if_not(std::begin(sd), std::end(sd), is_digit);
-      return sd.substr(static_cast<std::size_t>(it - std::begin(sd)));
-    };
+  static bool is_optional(std::string_view name,
+                          std::string_view prefix_chars) {
+    return !is_positional(name, prefix_chars);
+  }
 
-    switch (lookahead(s)) {
-    case '0': {
-      s.remove_prefix(1);
-      if (s.empty()) {
-        return true;
+  /*
+   * Get argument value given a type
+   * @throws std::logic_error in case of incompatible types
+   */
+  template <typename T> T get() const { return get<T>(m_state); }
+
+  template <typename T> T get(const State &state) const;
+
+  // Like get(), but reports the error get() would throw
+  template <typename T> Expected<T> try_get(const State &state) const {
+    using ValueType = typename std::conditional_t<details::IsContainer<T>,
+                                                  T, std::vector<T>>::value_type;
+    auto code = parse_errc{};
+    if (state.typed_values && state.typed_values->size() != 0) {
+      if (*m_value_type != typeid(ValueType)) {
+        code = parse_errc::wrong_type;
       }
-      goto integer_part;
-    }
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9': {
-      s = consume_digits(s);
-      if (s.empty()) {
-        return true;
+    } else if (!state.values.empty()) {
+      const auto holds = [](const std::any &value) {
+        return std::any_cast<ValueType>(&value) != nullptr;
+      };
+      if (!(details::IsContainer<T>
+                ? std::all_of(state.values.begin(), state.values.end(), holds)
+                : holds(state.values.front()))) {
+        code = parse_errc::wrong_type;
       }
-      goto integer_part_consumed;
-    }
-    case '.': {
-      s.remove_prefix(1);
-      goto post_decimal_point;
+    } else if (m_default_value.has_value()) {
+      if (std::any_cast<T>(&m_default_value) == nullptr) {
+        code = parse_errc::wrong_type;
+      }
+    } else if (!details::IsContainer<T> || m_accepts_optional_like_value) {
+      code = parse_errc::no_value;
     }
-    default:
-      return false;
+    if (code != parse_errc{}) {
+      return ParseError(code, this);
     }
+    return get<T>(state);
+  }
 
-  integer_part:
-    s = consume_digits(s);
-  integer_part_consumed:
-    switch (lookahead(s)) {
-    case '.': {
-      s.remove_prefix(1);
-      if (is_digit(lookahead(s))) {
-        goto post_decimal_point;
-      } else {
-        goto exponent_part_opt;
-      }
+  /*
+   * Get argument value given a type.
+   * @pre The object has no default value.
+   * @returns The stored value if any, std::nullopt otherwise.
+   */
+  template <typename T> auto present() const -> std::optional<T> {
+    return present<T>(m_state);
+  }
+
+  template <typename T>
+  auto present(const State &state) const -> std::optional<T>;
+
+  /*
+   * Get the values of an argument of type T without copying them. When no
+   * value was parsed, this is the default value if it is a std::vector<T>,
+   * and an empty vector otherwise.
+   * @throws std::logic_error if the type of the argument is not known
+   * @throws std::bad_any_cast if the argument is not of type T
+   */
+  template <typename T>
+  const std::vector<T> &get_view(const State &state) const {
+    if (m_value_type == nullptr) {
+      throw std::logic_error("No type given for '" + m_names.back() +
+                             "', use type<T>() or scan<>().");
     }
-    case 'e':
-    case 'E': {
-      s.remove_prefix(1);
-      goto post_e;
+    if (*m_value_type != typeid(T)) {
+      throw std::bad_any_cast();
     }
-    default:
-      return false;
+    if (state.typed_values) {
+      return static_cast<const TypedValuesOf<T> &>(*state.typed_values)
+          .values;
     }
-
-  post_decimal_point:
-    if (is_digit(lookahead(s))) {
-      s = consume_digits(s);
-      goto exponent_part_opt;
+    if (const auto *values =
+            std::any_cast<std::vector<T>>(&m_default_value)) {
+      return *values;
     }
-    return false;
+    static const std::vector<T> no_values;
+    return no_values;
+  }
 
-  exponent_part_opt:
-    switch (lookahead(s)) {
-    case eof:
-      return true;
-    case 'e':
-    case 'E': {
-      s.remove_prefix(1);
-      goto post_e;
-    }
-    default:
-      return false;
-    }
+  /*
+   * @returns The typed values of the argument if there are any and T is
+   * their type or a container of it, nullptr otherwise
+   * @throws std::bad_any_cast if the values are of another type
+   */
+  template <typename T>
+  const auto *typed_values_of(const State &state) const {
+    using ValueType = typename std::conditional_t<details::IsContainer<T>,
+                                                  T, std::vector<T>>::value_type;
+    const std::vector<ValueType> *values = nullptr;
+    if (!state.typed_values || state.typed_values->size() == 0) {
+      return values;
+    }
+    if (*m_value_type != typeid(ValueType)) {
+      throw std::bad_any_cast();
+    }
+    values = &static_cast<const TypedValuesOf<ValueType> &>(*state.typed_values)
+                  .values;
+    return values;
+  }
 
-  post_e:
-    switch (lookahead(s)) {
-    case '-':
-    case '+':
-      s.remove_prefix(1);
+  template <typename T, typename Converter> Argument &typed() {
+    m_typed_action = &append_typed<T, Converter>;
+    m_value_type = &typeid(T);
+    return *this;
+  }
+
+  template <typename T, typename Converter>
+  static T convert(std::string_view value) {
+    if constexpr (std::is_invocable_v<Converter, std::string_view>) {
+      return Converter()(value);
+    } else {
+      return Converter()(std::string(value));
     }
-    if (is_digit(lookahead(s))) {
-      s = consume_digits(s);
-      return s.empty();
+  }
+
+  // Converters which read plain decimal integers as parse_decimal_run does
+  template <typename T, typename Converter>
+  static constexpr bool is_decimal_converter =
+      details::standard_integer<T> &&
+      (std::is_base_of_v<details::parse_number<T, details::radix_10>,
+                         Converter> ||
+       std::is_base_of_v<details::parse_number<T>, Converter>);
+
+  /* Converts value into result without throwing, with the try_parse() of
+   * the built-in converters. The errors of other converters are caught.
+   */
+  template <typename T, typename Converter>
+  static std::errc try_convert(std::string_view value, T &result) {
+    if constexpr (details::HasTryParse<Converter, T>) {
+      return Converter::try_parse(value, result);
+    } else {
+      try {
+        result = convert<T, Converter>(value);
+      } catch (const std::range_error &) {
+        return std::errc::result_out_of_range;
+      } catch (const std::invalid_argument &) {
+        return std::errc::invalid_argument;
+      }
+      return {};
     }
-    return false;
   }
 
-  static bool is_optional(std::string_view name,
-                          std::string_view prefix_chars) {
-    return !is_positional(name, prefix_chars);
+  // Throws the error the Converter gives for value, once it is known to fail
+  template <typename T, typename Converter>
+  static void throw_conversion_error(std::string_view value) {
+    convert<T, Converter>(value);
   }
 
-  /*
-   * Get argument value given a type
-   * @throws std::logic_error in case of incompatible types
+  /* Appends values of the same type to a std::vector, converting runs of
+   * decimal integers at once. The Converter converts the other values.
+   * @returns false if a value is invalid, which is recorded in failure
    */
-  template <typename T> T get() const {
-    if (!m_values.empty()) {
-      if constexpr (details::IsContainer<T>) {
-        return any_cast_container<T>(m_values);
-      } else {
-        return std::any_cast<T>(m_values.front());
+  template <typename T, typename Converter>
+  static bool append_values(std::vector<T> &values,
+                            const std::string_view *first,
+                            const std::string_view *last,
+                            ConversionFailure &failure) {
+    while (first != last) {
+      if constexpr (is_decimal_converter<T, Converter>) {
+        first = details::parse_decimal_run(first, last, values);
+        if (first == last) {
+          break;
+        }
       }
-    }
-    if (m_default_value.has_value()) {
-      return std::any_cast<T>(m_default_value);
-    }
-    if constexpr (details::IsContainer<T>) {
-      if (!m_accepts_optional_like_value) {
-        return any_cast_container<T>(m_values);
+      T value{};
+      if (auto error = try_convert<T, Converter>(*first, value);
+          error != std::errc{}) {
+        failure = {first, error, &throw_conversion_error<T, Converter>};
+        return false;
       }
+      values.push_back(std::move(value));
+      ++first;
     }
+    return true;
+  }
 
-    throw std::logic_error("No value provided for '" + m_names.back() + "'.");
+  template <typename T, typename Converter>
+  static bool append_typed(State &state, const std::string_view *first,
+                           const std::string_view *last,
+                           ConversionFailure &failure) {
+    if (!state.typed_values) {
+      state.typed_values = std::make_unique<TypedValuesOf<T>>();
+    }
+    return append_values<T, Converter>(
+        static_cast<TypedValuesOf<T> &>(*state.typed_values).values, first,
+        last, failure);
   }
 
-  /*
-   * Get argument value given a type.
-   * @pre The object has no default value.
-   * @returns The stored value if any, std::nullopt otherwise.
+  /* Calls f with the values of [first, last) as an array of views, at once
+   * if they are already stored as one, until f returns false.
+   * @returns false if f did
    */
-  template <typename T> auto present() const -> std::optional<T> {
-    if (m_default_value.has_value()) {
-      throw std::logic_error("Argument with default value always presents");
-    }
-    if (m_values.empty()) {
-      return std::nullopt;
-    }
-    if constexpr (details::IsContainer<T>) {
-      return any_cast_container<T>(m_values);
+  template <typename Iterator, typename F>
+  static bool for_each_run(Iterator first, Iterator last, F &&f) {
+    if constexpr (std::is_same_v<
+                      Iterator,
+                      details::vector<std::string_view>::const_iterator>) {
+      return first == last || f(&*first, &*first + std::distance(first, last));
+    } else {
+      for (; first != last; ++first) {
+        const std::string_view value(*first);
+        if (!f(&value, &value + 1)) {
+          return false;
+        }
+      }
+      return true;
     }
-    return std::any_cast<T>(m_values.front());
   }
 
   template <typename T>
-  static auto any_cast_container(const std::vector<std::any> &operand) -> T {
+  static auto any_cast_container(const details::vector<std::any> &operand)
+      -> T {
     using ValueType = typename T::value_type;
 
     T result;
@@ -1599,82 +2767,369 @@ private:
     return result;
   }
 
+  /*
+   * Adds an action taking a view of the value. The std::string given to the
+   * actions of users is only created by the wrapper action() adds.
+   */
+  template <typename F> void add_action(F &&callable) {
+    using action_type = std::conditional_t<
+        std::is_void_v<std::invoke_result_t<F &, std::string_view>>,
+        void_action, valued_action>;
+    m_actions.emplace_back(std::in_place_type<action_type>,
+                           std::forward<F>(callable));
+  }
+
   void set_usage_newline_counter(int i) { m_usage_newline_counter = i; }
 
   void set_group_idx(std::size_t i) { m_group_idx = i; }
 
+  void set_index(std::size_t i) { m_index = i; }
+
+  // Drop the help and usage text cached by the parser of the argument
+  void changed_help() {
+    if (m_help_revision != nullptr) {
+      ++*m_help_revision;
+    }
+  }
+
   std::vector<std::string> m_names;
-  std::string_view m_used_name;
-  std::string m_help;
-  std::string m_metavar;
+  details::Text m_help;
+  details::Text m_metavar;
   std::any m_default_value;
   std::string m_default_value_repr;
   std::optional<std::string>
       m_default_value_str; // used for checking default_value against choices
   std::any m_implicit_value;
-  std::optional<std::vector<std::string>> m_choices{std::nullopt};
-  using valued_action = std::function<std::any(const std::string &)>;
-  using void_action = std::function<void(const std::string &)>;
+  std::optional<details::ChoiceSet> m_choices{std::nullopt};
+  // Actions are stored in place when they capture no more than a few
+  // references, as the built-in ones of store_into() do
+  using valued_action = details::InlineFunction<std::any(std::string_view)>;
+  using void_action = details::InlineFunction<void(std::string_view)>;
   std::vector<std::variant<valued_action, void_action>> m_actions;
+  // Appends a value to the typed storage, set by type<T>() and scan<>()
+  using typed_action = bool (*)(State &, const std::string_view *,
+                                const std::string_view *, ConversionFailure &);
+  typed_action m_typed_action = nullptr;
+  // Write the values into the containers given to store_into()
+  using store_action =
+      details::InlineFunction<bool(State &, const std::string_view *,
+                                   const std::string_view *,
+                                   ConversionFailure &)>;
+  std::vector<store_action> m_store_actions;
+  const std::type_info *m_value_type = nullptr;
   std::variant<valued_action, void_action> m_default_action{
     std::in_place_type<valued_action>,
-    [](const std::string &value) { return value; }};
-  std::vector<std::any> m_values;
+    [](std::string_view value) { return std::string(value); }};
+  State m_state; // used by the non-const ArgumentParser::parse_args
   NArgsRange m_num_args_range{1, 1};
   // Bit field of bool values. Set default value in ctor.
   bool m_accepts_optional_like_value : 1;
   bool m_is_optional : 1;
   bool m_is_required : 1;
   bool m_is_repeatable : 1;
-  bool m_is_used : 1;
   bool m_is_hidden : 1;            // if set, does not appear in usage or help
   std::string_view m_prefix_chars; // ArgumentParser has the prefix_chars
   int m_usage_newline_counter = 0;
   std::size_t m_group_idx = 0;
+  std::size_t m_index = 0; // position of the argument in its parser
+  const ArgumentParser *m_parser = nullptr; // parser the argument belongs to
+  std::size_t *m_help_revision = nullptr; // ArgumentParser has the revision
 };
 
-class ArgumentParser {
-public:
-  explicit ArgumentParser(std::string program_name = {},
-                          std::string version = "1.0",
-                          default_arguments add_args = default_arguments::all,
-                          bool exit_on_default_arguments = true,
-                          std::ostream &os = std::cout)
-      : m_program_name(std::move(program_name)), m_version(std::move(version)),
-        m_exit_on_default_arguments(exit_on_default_arguments),
-        m_parser_path(m_program_name) {
-    if ((add_args & default_arguments::help) == default_arguments::help) {
-      add_argument("-h", "--help")
-          .action([&](const auto & /*unused*/) {
-            os << help().str();
-            if (m_exit_on_default_arguments) {
-              std::exit(0);
-            }
-          })
-          .default_value(false)
-          .help("shows help message and exits")
-          .implicit_value(true)
-          .nargs(0);
-    }
-    if ((add_args & default_arguments::version) == default_arguments::version) {
-      add_argument("-v", "--version")
-          .action([&](const auto & /*unused*/) {
-            os << m_version << std::endl;
-            if (m_exit_on_default_arguments) {
-              std::exit(0);
-            }
-          })
-          .default_value(false)
-          .help("prints version information and exits")
-          .implicit_value(true)
-          .nargs(0);
-    }
-  }
-
-  ~ArgumentParser() = default;
+/* Values parsed from a command line by a const ArgumentParser.
+ * The result refers to the parser it was produced by to look up arguments by
+ * name, so it must not outlive that parser.
+ */
+class ParseResult {
+  friend class ArgumentParser;
+  template <typename T> friend class ArgHandle;
 
-  // ArgumentParser is meant to be used in a single function.
-  // Setup everything and parse arguments in one place.
+public:
+  /* Getter for options with default values.
+   * @throws std::logic_error if there is no such option
+   * @throws std::logic_error if the option has no value
+   * @throws std::bad_any_cast if the option is not of type T
+   */
+  template <typename T = std::string> T get(std::string_view arg_name) const;
+
+  /* Getter for options without default values.
+   * @pre The option has no default value.
+   * @throws std::logic_error if there is no such option
+   * @throws std::bad_any_cast if the option is not of type T
+   */
+  template <typename T = std::string>
+  auto present(std::string_view arg_name) const -> std::optional<T>;
+
+  /* Getter for the values of an argument stored with type<T>() or scan<>(),
+   * without copying them.
+   * @throws std::logic_error if there is no such option
+   * @throws std::logic_error if the option has no stored type
+   * @throws std::bad_any_cast if the option is not of type T
+   */
+  template <typename T>
+  const std::vector<T> &get_view(std::string_view arg_name) const;
+
+  /* Like get(), but reports the errors get() would throw in the returned
+   * value, with the codes parse_errc::no_such_argument, no_value and
+   * wrong_type.
+   */
+  template <typename T = std::string>
+  Expected<T> try_get(std::string_view arg_name) const;
+
+  /* Getter that returns true for user-supplied options. Returns false if not
+   * user-supplied, even with a default value.
+   */
+  bool is_used(std::string_view arg_name) const;
+
+  /* Getter that returns true if a subcommand is used.
+   */
+  bool is_subcommand_used(std::string_view subcommand_name) const {
+    return m_subresult != nullptr && m_subcommand == subcommand_name;
+  }
+
+  /* Getter for the values parsed by a subparser.
+   * @throws std::logic_error if the subcommand was not used
+   */
+  const ParseResult &at(std::string_view subcommand_name) const {
+    if (!is_subcommand_used(subcommand_name)) {
+      throw std::logic_error("Subcommand not used: " +
+                             std::string(subcommand_name));
+    }
+    return *m_subresult;
+  }
+
+  /* Arguments left over by parse_known_args().
+   */
+  const std::vector<std::string> &unknown_arguments() const {
+    return m_unknown_arguments;
+  }
+
+  explicit operator bool() const {
+    auto arg_used = std::any_of(m_states.cbegin(), m_states.cend(),
+                                [](const auto &state) { return state.is_used; });
+    return m_is_parsed && (arg_used || m_subresult != nullptr);
+  }
+
+private:
+  ParseResult(const ArgumentParser &parser, bool from_parser_state,
+              const details::allocator<std::byte> &allocator);
+
+  Argument::State &state_of(const Argument &argument) {
+    return m_states[argument.m_index];
+  }
+
+  const Argument::State &state_of(const Argument &argument) const {
+    return m_states[argument.m_index];
+  }
+
+  const ArgumentParser *m_parser;
+  details::vector<Argument::State> m_states;
+  std::vector<std::string> m_unknown_arguments;
+  std::string_view m_subcommand;
+  std::unique_ptr<ParseResult> m_subresult;
+  bool m_is_parsed = false;
+  // Start from the state stored in the arguments, used by the non-const
+  // parse_args() which writes the result back into the parser.
+  bool m_from_parser_state = false;
+};
+
+/* A typed handle to an argument, from Argument::handle<T>(). Reading a value
+ * through it costs no string allocation nor name lookup. The values of an
+ * argument stored with type<T>() or scan<>() are read directly, their type
+ * being checked once when the handle is made, after type<T>() or scan<>().
+ * The handle refers to the argument, so it must not outlive its parser.
+ */
+template <typename T> class ArgHandle {
+  friend class Argument;
+
+public:
+  /* Value stored by parse_args().
+   * @throws std::logic_error if the argument has no value
+   * @throws std::bad_any_cast if the argument is not of type T
+   */
+  T get() const { return get_from(m_argument->m_state); }
+
+  /* Value in the result of parse() with the argument's parser.
+   * @throws std::logic_error if the argument has no value, or if the result
+   * is of another parser
+   * @throws std::bad_any_cast if the argument is not of type T
+   */
+  T get(const ParseResult &result) const {
+    return get_from(state_in(result));
+  }
+
+  auto present() const -> std::optional<T> {
+    return present_in(m_argument->m_state);
+  }
+
+  auto present(const ParseResult &result) const -> std::optional<T> {
+    return present_in(state_in(result));
+  }
+
+  /* All values of an argument stored with type<T>() or scan<>(), without
+   * copying them.
+   * @throws std::logic_error if the argument has no stored type
+   * @throws std::bad_any_cast if the argument is not of type T
+   */
+  const std::vector<T> &get_view() const {
+    return m_argument->get_view<T>(m_argument->m_state);
+  }
+
+  const std::vector<T> &get_view(const ParseResult &result) const {
+    return m_argument->get_view<T>(state_in(result));
+  }
+
+  bool is_used() const { return m_argument->m_state.is_used; }
+
+  bool is_used(const ParseResult &result) const {
+    return state_in(result).is_used;
+  }
+
+private:
+  using value_type =
+      typename std::conditional_t<details::IsContainer<T>, T,
+                                  std::vector<T>>::value_type;
+
+  // @throws std::bad_any_cast if the argument is stored as another type
+  explicit ArgHandle(const Argument &argument)
+      : m_argument(&argument), m_is_typed(argument.m_value_type != nullptr) {
+    if (m_is_typed && *argument.m_value_type != typeid(value_type)) {
+      throw std::bad_any_cast();
+    }
+  }
+
+  // The typed values in state, nullptr if there are none
+  const std::vector<value_type> *
+  typed_values(const Argument::State &state) const {
+    if (!m_is_typed || !state.typed_values ||
+        state.typed_values->size() == 0) {
+      return nullptr;
+    }
+    return &static_cast<const Argument::TypedValuesOf<value_type> &>(
+                *state.typed_values)
+                .values;
+  }
+
+  static T value_of(const std::vector<value_type> &values) {
+    if constexpr (details::IsContainer<T>) {
+      return T(values.begin(), values.end());
+    } else {
+      return values.front();
+    }
+  }
+
+  T get_from(const Argument::State &state) const {
+    if (const auto *values = typed_values(state)) {
+      return value_of(*values);
+    }
+    return m_argument->get<T>(state);
+  }
+
+  std::optional<T> present_in(const Argument::State &state) const {
+    if (const auto *values = typed_values(state)) {
+      if (m_argument->m_default_value.has_value()) {
+        throw std::logic_error("Argument with default value always presents");
+      }
+      return value_of(*values);
+    }
+    return m_argument->present<T>(state);
+  }
+
+  // @throws std::logic_error if the result is not from the argument's parser
+  const Argument::State &state_in(const ParseResult &result) const {
+    if (result.m_parser != m_argument->m_parser) {
+      throw std::logic_error("Result of another parser given for '" +
+                             m_argument->m_names.back() + "'.");
+    }
+    return result.state_of(*m_argument);
+  }
+
+  const Argument *m_argument;
+  bool m_is_typed;
+};
+
+/* What help shows of an argument, for generating documentation with
+ * ArgumentParser::describe(). The views refer to the argument.
+ */
+struct ArgumentInfo {
+  std::vector<std::string_view> names; // without hidden aliases
+  std::string_view help;
+  std::string_view metavar;
+  // Number of values, nargs_max is SIZE_MAX if there is no upper bound
+  std::size_t nargs_min = 1;
+  std::size_t nargs_max = 1;
+  std::optional<std::string_view> default_value; // as shown in help
+  std::vector<std::string_view> choices;         // empty if any value
+  bool is_positional = false;
+  bool is_required = false;
+  bool is_repeatable = false;
+  bool is_hidden = false;
+  std::size_t group = 0;       // i for the i-th add_group(), 0 for none
+  std::size_t mutex_group = 0; // i for the i-th mutex group, 0 for none
+};
+
+struct MutexGroupInfo {
+  std::vector<std::size_t> arguments; // indices in ParserInfo::arguments
+  bool is_required = false;
+};
+
+struct SubcommandInfo {
+  std::string_view name;
+  std::string_view description;
+  const ArgumentParser *parser = nullptr;
+  bool is_hidden = false; // set_suppress()
+};
+
+struct ParserInfo {
+  std::string_view program_name;
+  std::string_view path; // e.g. "git remote add"
+  std::string_view version;
+  std::string_view description;
+  std::string_view epilog;
+  // A copy, as the usage is rendered again when a subcommand is built
+  std::string usage;
+  std::vector<ArgumentInfo> arguments; // in the order they were added
+  std::vector<std::string_view> groups;
+  std::vector<MutexGroupInfo> mutex_groups;
+  std::vector<SubcommandInfo> subcommands; // sorted by name
+};
+
+class ArgumentParser {
+  friend class ParseResult;
+  friend class ParseError;
+
+public:
+  // A std::pmr::polymorphic_allocator<std::byte> when <memory_resource> is
+  // available, so a std::pmr::memory_resource * can be given.
+  using allocator_type = details::allocator<std::byte>;
+
+  /* The lists and maps holding the arguments and subparsers, and the lists
+   * of values of parse_args(), are allocated with allocator.
+   * The names, help texts and actions of the arguments, and the values the
+   * lists hold, are allocated on the global heap.
+   */
+  explicit ArgumentParser(std::string program_name = {},
+                          std::string version = "1.0",
+                          default_arguments add_args = default_arguments::all,
+                          bool exit_on_default_arguments = true,
+                          std::ostream &os = std::cout,
+                          const allocator_type &allocator = {})
+      : m_program_name(std::move(program_name)), m_version(std::move(version)),
+        m_exit_on_default_arguments(exit_on_default_arguments),
+        m_default_arguments(add_args), m_os(os),
+        m_parser_path(m_program_name), m_allocator(allocator),
+        m_positional_arguments(allocator), m_optional_arguments(allocator),
+        m_default_argument_list(allocator), m_argument_map(allocator),
+        m_argument_index(allocator), m_option_names(allocator),
+        m_subparsers(allocator), m_subparser_map(allocator),
+        m_subcommand_names(allocator),
+        m_subparser_used(allocator), m_mutex_of_argument(allocator),
+        m_group_arguments(allocator) {}
+
+  ~ArgumentParser() = default;
+
+  // ArgumentParser is meant to be used in a single function.
+  // Setup everything and parse arguments in one place.
   //
   // ArgumentParser internally uses std::string_views,
   // references, iterators, etc.
@@ -1684,33 +3139,13 @@ public:
   ArgumentParser(ArgumentParser &&) noexcept = delete;
   ArgumentParser &operator=(ArgumentParser &&) = delete;
 
-  explicit operator bool() const {
-    auto arg_used = std::any_of(m_argument_map.cbegin(), m_argument_map.cend(),
-                                [](auto &it) { return it.second->m_is_used; });
-    auto subparser_used =
-        std::any_of(m_subparser_used.cbegin(), m_subparser_used.cend(),
-                    [](auto &it) { return it.second; });
-
-    return m_is_parsed && (arg_used || subparser_used);
-  }
+  explicit operator bool() const;
 
   // Parameter packing
   // Call add_argument with variadic number of string arguments
   template <typename... Targs> Argument &add_argument(Targs... f_args) {
-    using array_of_sv = std::array<std::string_view, sizeof...(Targs)>;
-    auto argument =
-        m_optional_arguments.emplace(std::cend(m_optional_arguments),
-                                     m_prefix_chars, array_of_sv{f_args...});
-
-    if (!argument->m_is_optional) {
-      m_positional_arguments.splice(std::cend(m_positional_arguments),
-                                    m_optional_arguments, argument);
-    }
-    argument->set_usage_newline_counter(m_usage_newline_counter);
-    argument->set_group_idx(m_group_names.size());
-
-    index_argument(argument);
-    return *argument;
+    const std::array<std::string_view, sizeof...(Targs)> names{f_args...};
+    return add_argument_names(names.data(), names.size());
   }
 
   class MutuallyExclusiveGroup {
@@ -1729,27 +3164,33 @@ public:
 
     MutuallyExclusiveGroup(MutuallyExclusiveGroup &&other) noexcept
         : m_parent(other.m_parent), m_required(other.m_required),
-          m_elements(std::move(other.m_elements)) {
+          m_elements(std::move(other.m_elements)), m_index(other.m_index) {
       other.m_elements.clear();
     }
 
     template <typename... Targs> Argument &add_argument(Targs... f_args) {
-      auto &argument = m_parent.add_argument(std::forward<Targs>(f_args)...);
+      return add(m_parent.add_argument(std::forward<Targs>(f_args)...));
+    }
+
+  private:
+    Argument &add(Argument &argument) {
       m_elements.push_back(&argument);
+      m_parent.m_mutex_of_argument[argument.m_index] = m_index + 1;
       argument.set_usage_newline_counter(m_parent.m_usage_newline_counter);
       argument.set_group_idx(m_parent.m_group_names.size());
       return argument;
     }
 
-  private:
     ArgumentParser &m_parent;
     bool m_required{false};
     std::vector<Argument *> m_elements{};
+    std::size_t m_index = 0; // position of the group in its parser
   };
 
   MutuallyExclusiveGroup &add_mutually_exclusive_group(bool required = false) {
-    m_mutually_exclusive_groups.emplace_back(*this, required);
-    return m_mutually_exclusive_groups.back();
+    auto &group = m_mutually_exclusive_groups.emplace_back(*this, required);
+    group.m_index = m_mutually_exclusive_groups.size() - 1;
+    return group;
   }
 
   // Parameter packed add_parents method
@@ -1785,33 +3226,46 @@ public:
   // also used.
   ArgumentParser &add_group(std::string group_name) {
     m_group_names.emplace_back(std::move(group_name));
+    ++m_help_revision;
+    return *this;
+  }
+
+  ArgumentParser &add_group(StaticText group_name) {
+    m_group_names.emplace_back(group_name);
+    ++m_help_revision;
     return *this;
   }
 
   ArgumentParser &add_description(std::string description) {
     m_description = std::move(description);
+    ++m_help_revision;
+    return *this;
+  }
+
+  // Keeps a view of the text instead of a copy, as the overloads of
+  // add_group() and add_epilog() taking a StaticText do
+  ArgumentParser &add_description(StaticText description) {
+    m_description = description;
+    ++m_help_revision;
     return *this;
   }
 
   ArgumentParser &add_epilog(std::string epilog) {
     m_epilog = std::move(epilog);
+    ++m_help_revision;
+    return *this;
+  }
+
+  ArgumentParser &add_epilog(StaticText epilog) {
+    m_epilog = epilog;
+    ++m_help_revision;
     return *this;
   }
 
   // Add a un-documented/hidden alias for an argument.
   // Ideally we'd want this to be a method of Argument, but Argument
   // does not own its owing ArgumentParser.
-  ArgumentParser &add_hidden_alias_for(Argument &arg, std::string_view alias) {
-    for (auto it = m_optional_arguments.begin();
-         it != m_optional_arguments.end(); ++it) {
-      if (&(*it) == &arg) {
-        m_argument_map.insert_or_assign(std::string(alias), it);
-        return *this;
-      }
-    }
-    throw std::logic_error(
-        "Argument is not an optional argument of this parser");
-  }
+  ArgumentParser &add_hidden_alias_for(Argument &arg, std::string_view alias);
 
   /* Getter for arguments and subparsers.
    * @throws std::logic_error in case of an invalid argument or subparser name
@@ -1831,6 +3285,8 @@ public:
 
   ArgumentParser &set_prefix_chars(std::string prefix_chars) {
     m_prefix_chars = std::move(prefix_chars);
+    m_prefix_char_set = details::CharSet(m_prefix_chars);
+    ++m_help_revision;
     return *this;
   }
 
@@ -1845,48 +3301,26 @@ public:
    * @throws std::runtime_error in case of any invalid argument
    */
   void parse_args(const std::vector<std::string> &arguments) {
-    parse_args_internal(arguments);
-    // Check if all arguments are parsed
-    for ([[maybe_unused]] const auto &[unused, argument] : m_argument_map) {
-      argument->validate();
-    }
-
-    // Check each mutually exclusive group and make sure
-    // there are no constraint violations
-    for (const auto &group : m_mutually_exclusive_groups) {
-      auto mutex_argument_used{false};
-      Argument *mutex_argument_it{nullptr};
-      for (Argument *arg : group.m_elements) {
-        if (!mutex_argument_used && arg->m_is_used) {
-          mutex_argument_used = true;
-          mutex_argument_it = arg;
-        } else if (mutex_argument_used && arg->m_is_used) {
-          // Violation
-          throw std::runtime_error("Argument '" + arg->get_usage_full() +
-                                   "' not allowed with '" +
-                                   mutex_argument_it->get_usage_full() + "'");
-        }
-      }
+    parse_args_and_store(tokens_type(arguments.begin(), arguments.end(),
+                                     m_allocator));
+  }
 
-      if (!mutex_argument_used && group.m_required) {
-        // at least one argument from the group is
-        // required
-        std::string argument_names{};
-        std::size_t i = 0;
-        std::size_t size = group.m_elements.size();
-        for (Argument *arg : group.m_elements) {
-          if (i + 1 == size) {
-            // last
-            argument_names += std::string("'") + arg->get_usage_full() + std::string("' ");
-          } else {
-            argument_names += std::string("'") + arg->get_usage_full() + std::string("' or ");
-          }
-          i += 1;
-        }
-        throw std::runtime_error("One of the arguments " + argument_names +
-                                 "is required");
-      }
-    }
+  /* Parse arguments without modifying this parser, unlike parse_args(). The
+   * parsed values are returned in a ParseResult, so a parser that is fully
+   * set up can be shared between threads and reused for any number of
+   * command lines.
+   * Actions with side effects, e.g. store_into(), are still performed.
+   * The tokens, the states of the arguments in the result and their lists of
+   * std::any come from allocator, e.g. a std::pmr::monotonic_buffer_resource
+   * released after each request. The global heap still holds what a std::any
+   * allocates for its value, the values of arguments of a known type (see
+   * Argument::type<T>()), unknown_arguments() and the result of a subcommand.
+   * @throws std::runtime_error in case of any invalid argument
+   */
+  ParseResult parse(const std::vector<std::string> &arguments,
+                    const allocator_type &allocator = {}) const {
+    return parse_args_to_result(
+        tokens_type(arguments.begin(), arguments.end(), allocator));
   }
 
   /* Call parse_known_args_internal - which does all the work
@@ -1896,21 +3330,34 @@ public:
    */
   std::vector<std::string>
   parse_known_args(const std::vector<std::string> &arguments) {
-    auto unknown_arguments = parse_known_args_internal(arguments);
-    // Check if all arguments are parsed
-    for ([[maybe_unused]] const auto &[unused, argument] : m_argument_map) {
-      argument->validate();
-    }
-    return unknown_arguments;
+    return parse_known_args_and_store(
+        tokens_type(arguments.begin(), arguments.end(), m_allocator));
+  }
+
+  /* Like parse_known_args() without modifying this parser, as parse() does.
+   * The unknown arguments are available from ParseResult::unknown_arguments().
+   * @throws std::runtime_error in case of any invalid argument
+   */
+  ParseResult parse_known(const std::vector<std::string> &arguments,
+                          const allocator_type &allocator = {}) const {
+    return parse_known_args_to_result(
+        tokens_type(arguments.begin(), arguments.end(), allocator));
   }
 
   /* Main entry point for parsing command-line arguments using this
-   * ArgumentParser
+   * ArgumentParser. The arguments are not copied, the parser works on views
+   * of argv and only copies the values it stores.
    * @throws std::runtime_error in case of any invalid argument
    */
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
   void parse_args(int argc, const char *const argv[]) {
-    parse_args({argv, argv + argc});
+    parse_args_and_store(tokens_type(argv, argv + argc, m_allocator));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+  ParseResult parse(int argc, const char *const argv[],
+                    const allocator_type &allocator = {}) const {
+    return parse_args_to_result(tokens_type(argv, argv + argc, allocator));
   }
 
   /* Main entry point for parsing command-line arguments using this
@@ -1919,7 +3366,39 @@ public:
    */
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
   auto parse_known_args(int argc, const char *const argv[]) {
-    return parse_known_args({argv, argv + argc});
+    return parse_known_args_and_store(
+        tokens_type(argv, argv + argc, m_allocator));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+  ParseResult parse_known(int argc, const char *const argv[],
+                          const allocator_type &allocator = {}) const {
+    return parse_known_args_to_result(
+        tokens_type(argv, argv + argc, allocator));
+  }
+
+  /* Like parse(), but an invalid command line is reported in the returned
+   * value instead of by an exception, e.g.
+   *
+   *   auto result = program.try_parse(argc, argv);
+   *   if (!result) {
+   *     std::cerr << result.error().message() << std::endl;
+   *   }
+   *
+   * The ParseError refers to argv and to this parser. Its message is only
+   * built by ParseError::message(). Exceptions thrown by actions other than
+   * std::invalid_argument and std::range_error are not caught.
+   */
+  Expected<ParseResult> try_parse(const std::vector<std::string> &arguments,
+                                  const allocator_type &allocator = {}) const {
+    return try_parse_args_to_result(
+        tokens_type(arguments.begin(), arguments.end(), allocator));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+  Expected<ParseResult> try_parse(int argc, const char *const argv[],
+                                  const allocator_type &allocator = {}) const {
+    return try_parse_args_to_result(tokens_type(argv, argv + argc, allocator));
   }
 
   /* Getter for options with default values.
@@ -1928,12 +3407,7 @@ public:
    * @throws std::logic_error if the option has no value
    * @throws std::bad_any_cast if the option is not of type T
    */
-  template <typename T = std::string> T get(std::string_view arg_name) const {
-    if (!m_is_parsed) {
-      throw std::logic_error("Nothing parsed, no arguments are available.");
-    }
-    return (*this)[arg_name].get<T>();
-  }
+  template <typename T = std::string> T get(std::string_view arg_name) const;
 
   /* Getter for options without default values.
    * @pre The option has no default value.
@@ -1941,21 +3415,40 @@ public:
    * @throws std::bad_any_cast if the option is not of type T
    */
   template <typename T = std::string>
-  auto present(std::string_view arg_name) const -> std::optional<T> {
-    return (*this)[arg_name].present<T>();
+  auto present(std::string_view arg_name) const -> std::optional<T>;
+
+  /* Getter for the values of an argument stored with type<T>() or scan<>(),
+   * without copying them.
+   * @throws std::logic_error if parse_args() has not been previously called
+   * @throws std::logic_error if there is no such option
+   * @throws std::logic_error if the option has no stored type
+   * @throws std::bad_any_cast if the option is not of type T
+   */
+  template <typename T>
+  const std::vector<T> &get_view(std::string_view arg_name) const {
+    if (!m_is_parsed) {
+      throw std::logic_error("Nothing parsed, no arguments are available.");
+    }
+    const auto &argument = (*this)[arg_name];
+    return argument.get_view<T>(argument.m_state);
   }
 
   /* Getter that returns true for user-supplied options. Returns false if not
    * user-supplied, even with a default value.
    */
   auto is_used(std::string_view arg_name) const {
-    return (*this)[arg_name].m_is_used;
+    return (*this)[arg_name].m_state.is_used;
   }
 
   /* Getter that returns true if a subcommand is used.
    */
   auto is_subcommand_used(std::string_view subcommand_name) const {
-    return m_subparser_used.at(std::string(subcommand_name));
+    auto it = m_subparser_used.find(subcommand_name);
+    if (it == m_subparser_used.end()) {
+      throw std::out_of_range("No such subparser: " +
+                              std::string(subcommand_name));
+    }
+    return it->second;
   }
 
   /* Getter that returns true if a subcommand is used.
@@ -1969,110 +3462,27 @@ public:
    * @throws std::logic_error in case of an invalid argument name
    */
   Argument &operator[](std::string_view arg_name) const {
-    std::string name(arg_name);
-    auto it = m_argument_map.find(name);
-    if (it != m_argument_map.end()) {
-      return *(it->second);
-    }
-    if (!is_valid_prefix_char(arg_name.front())) {
-      const auto legal_prefix_char = get_any_valid_prefix_char();
-      const auto prefix = std::string(1, legal_prefix_char);
-
-      // "-" + arg_name
-      name = prefix + name;
-      it = m_argument_map.find(name);
-      if (it != m_argument_map.end()) {
-        return *(it->second);
-      }
-      // "--" + arg_name
-      name = prefix + name;
-      it = m_argument_map.find(name);
-      if (it != m_argument_map.end()) {
-        return *(it->second);
-      }
+    if (auto *argument = lookup_argument(arg_name)) {
+      return *argument;
     }
     throw std::logic_error("No such argument: " + std::string(arg_name));
   }
 
+  /* Build a flat index of the names of the arguments of this parser and of
+   * its subparsers, which speeds up looking up arguments while parsing, and
+   * of the names suggested for unknown options.
+   * parse_args() indexes the names on its own, a parser that is shared to be
+   * parsed with parse() should be frozen once set up. Adding arguments
+   * afterwards drops the index until the next freeze().
+   */
+  ArgumentParser &freeze();
+
   // Print help message
   friend auto operator<<(std::ostream &stream, const ArgumentParser &parser)
       -> std::ostream & {
-    stream.setf(std::ios_base::left);
-
-    auto longest_arg_length = parser.get_length_of_longest_argument();
-
-    stream << parser.usage() << "\n\n";
-
-    if (!parser.m_description.empty()) {
-      stream << parser.m_description << "\n\n";
-    }
-
-    const bool has_visible_positional_args = std::find_if(
-      parser.m_positional_arguments.begin(),
-      parser.m_positional_arguments.end(),
-      [](const auto &argument) {
-      return !argument.m_is_hidden; }) !=
-      parser.m_positional_arguments.end();
-    if (has_visible_positional_args) {
-      stream << "Positional arguments:\n";
-    }
-
-    for (const auto &argument : parser.m_positional_arguments) {
-      if (!argument.m_is_hidden) {
-        stream.width(static_cast<std::streamsize>(longest_arg_length));
-        stream << argument;
-      }
-    }
-
-    if (!parser.m_optional_arguments.empty()) {
-      stream << (!has_visible_positional_args ? "" : "\n")
-             << "Optional arguments:\n";
-    }
-
-    for (const auto &argument : parser.m_optional_arguments) {
-      if (argument.m_group_idx == 0 && !argument.m_is_hidden) {
-        stream.width(static_cast<std::streamsize>(longest_arg_length));
-        stream << argument;
-      }
-    }
-
-    for (size_t i_group = 0; i_group < parser.m_group_names.size(); ++i_group) {
-      stream << "\n" << parser.m_group_names[i_group] << " (detailed usage):\n";
-      for (const auto &argument : parser.m_optional_arguments) {
-        if (argument.m_group_idx == i_group + 1 && !argument.m_is_hidden) {
-          stream.width(static_cast<std::streamsize>(longest_arg_length));
-          stream << argument;
-        }
-      }
-    }
-
-    bool has_visible_subcommands = std::any_of(
-        parser.m_subparser_map.begin(), parser.m_subparser_map.end(),
-        [](auto &p) { return !p.second->get().m_suppress; });
-
-    if (has_visible_subcommands) {
-      stream << (parser.m_positional_arguments.empty()
-                     ? (parser.m_optional_arguments.empty() ? "" : "\n")
-                     : "\n")
-             << "Subcommands:\n";
-      for (const auto &[command, subparser] : parser.m_subparser_map) {
-        if (subparser->get().m_suppress) {
-          continue;
-        }
-
-        stream << std::setw(2) << " ";
-        stream << std::setw(static_cast<int>(longest_arg_length - 2))
-               << command;
-        stream << " " << subparser->get().m_description << "\n";
-      }
-    }
-
-    if (!parser.m_epilog.empty()) {
-      stream << '\n';
-      stream << parser.m_epilog << "\n\n";
-    }
-
-    return stream;
+    const auto text = parser.help_text();
+    return stream.write(text->data(),
+                        static_cast<std::streamsize>(text->size()));
   }
 
   // Format help message
@@ -2082,9 +3492,43 @@ public:
     return out;
   }
 
+  /* The help message, rendered once and kept until this parser, one of its
+   * arguments or one of its subparsers is changed. Rendering it again makes
+   * a new text, so the one returned stays valid and unchanged for as long as
+   * it is held, even while other threads parse with the parser.
+   */
+  std::shared_ptr<const std::string> help_text() const {
+    return rendered_help().help;
+  }
+
+  // The usage part of help, kept like help_text()
+  std::shared_ptr<const std::string> usage_text() const {
+    return rendered_help().usage;
+  }
+
+  // Copy the help message to out, e.g. a char * or std::back_inserter
+  template <typename OutputIt> OutputIt format_help(OutputIt out) const {
+    const auto text = help_text();
+    return std::copy(text->begin(), text->end(), out);
+  }
+
+  // Copy the usage part of help to out
+  template <typename OutputIt> OutputIt format_usage(OutputIt out) const {
+    const auto text = usage_text();
+    return std::copy(text->begin(), text->end(), out);
+  }
+
+  /* Describe the arguments, groups and subcommands of this parser, for
+   * generating documentation. The views refer to the parser and are valid
+   * until it is changed. See argparse/doc_export.hpp to export a whole tree
+   * of parsers as man pages, Markdown or JSON.
+   */
+  ParserInfo describe() const;
+
   // Sets the maximum width for a line of the Usage message
   ArgumentParser &set_usage_max_line_width(size_t w) {
     this->m_usage_max_line_width = w;
+    ++m_help_revision;
     return *this;
   }
 
@@ -2092,498 +3536,2105 @@ public:
   // the Usage message
   ArgumentParser &set_usage_break_on_mutex() {
     this->m_usage_break_on_mutex = true;
+    ++m_help_revision;
     return *this;
   }
 
   // Format usage part of help only
-  auto usage() const -> std::string {
-    std::stringstream stream;
-
-    std::string curline("Usage: ");
-    curline += this->m_parser_path;
-    const bool multiline_usage =
-        this->m_usage_max_line_width < (std::numeric_limits<std::size_t>::max)();
-    const size_t indent_size = curline.size();
-
-    const auto deal_with_options_of_group = [&](std::size_t group_idx) {
-      bool found_options = false;
-      // Add any options inline here
-      const MutuallyExclusiveGroup *cur_mutex = nullptr;
-      int usage_newline_counter = -1;
-      for (const auto &argument : this->m_optional_arguments) {
-        if (argument.m_is_hidden) {
-          continue;
-        }
-        if (multiline_usage) {
-          if (argument.m_group_idx != group_idx) {
-            continue;
-          }
-          if (usage_newline_counter != argument.m_usage_newline_counter) {
-            if (usage_newline_counter >= 0) {
-              if (curline.size() > indent_size) {
-                stream << curline << std::endl;
-                curline = std::string(indent_size, ' ');
-              }
-            }
-            usage_newline_counter = argument.m_usage_newline_counter;
-          }
-        }
-        found_options = true;
-        const std::string arg_inline_usage = argument.get_inline_usage();
-        const MutuallyExclusiveGroup *arg_mutex =
-            get_belonging_mutex(&argument);
-        if ((cur_mutex != nullptr) && (arg_mutex == nullptr)) {
-          curline += ']';
-          if (this->m_usage_break_on_mutex) {
-            stream << curline << std::endl;
-            curline = std::string(indent_size, ' ');
-          }
-        } else if ((cur_mutex == nullptr) && (arg_mutex != nullptr)) {
-          if ((this->m_usage_break_on_mutex && curline.size() > indent_size) ||
-              curline.size() + 3 + arg_inline_usage.size() >
-                  this->m_usage_max_line_width) {
-            stream << curline << std::endl;
-            curline = std::string(indent_size, ' ');
-          }
-          curline += " [";
-        } else if ((cur_mutex != nullptr) && (arg_mutex != nullptr)) {
-          if (cur_mutex != arg_mutex) {
-            curline += ']';
-            if (this->m_usage_break_on_mutex ||
-                curline.size() + 3 + arg_inline_usage.size() >
-                    this->m_usage_max_line_width) {
-              stream << curline << std::endl;
-              curline = std::string(indent_size, ' ');
-            }
-            curline += " [";
-          } else {
-            curline += '|';
-          }
-        }
-        cur_mutex = arg_mutex;
-        if (curline.size() != indent_size &&
-            curline.size() + 1 + arg_inline_usage.size() >
-            this->m_usage_max_line_width) {
-          stream << curline << std::endl;
-          curline = std::string(indent_size, ' ');
-          curline += " ";
-        } else if (cur_mutex == nullptr) {
-          curline += " ";
-        }
-        curline += arg_inline_usage;
-      }
-      if (cur_mutex != nullptr) {
-        curline += ']';
-      }
-      return found_options;
-    };
+  auto usage() const -> std::string { return *usage_text(); }
 
-    const bool found_options = deal_with_options_of_group(0);
-
-    if (found_options && multiline_usage &&
-        !this->m_positional_arguments.empty()) {
-      stream << curline << std::endl;
-      curline = std::string(indent_size, ' ');
-    }
-    // Put positional arguments after the optionals
-    for (const auto &argument : this->m_positional_arguments) {
-      if (argument.m_is_hidden) {
-        continue;
-      }
-      const std::string pos_arg = !argument.m_metavar.empty()
-                                      ? argument.m_metavar
-                                      : argument.m_names.front();
-      if (curline.size() + 1 + pos_arg.size() > this->m_usage_max_line_width) {
-        stream << curline << std::endl;
-        curline = std::string(indent_size, ' ');
-      }
-      curline += " ";
-      if (argument.m_num_args_range.get_min() == 0 &&
-          !argument.m_num_args_range.is_right_bounded()) {
-        curline += "[";
-        curline += pos_arg;
-        curline += "]...";
-      } else if (argument.m_num_args_range.get_min() == 1 &&
-                 !argument.m_num_args_range.is_right_bounded()) {
-        curline += pos_arg;
-        curline += "...";
-      } else {
-        curline += pos_arg;
+  // Printing the one and only help message
+  // I've stuck with a simple message format, nothing fancy.
+  [[deprecated("Use cout << program; instead.  See also help().")]] std::string
+  print_help() const {
+    auto out = help();
+    std::cout << out.rdbuf();
+    return out.str();
+  }
+
+  void add_subparser(ArgumentParser &parser) {
+    parser.m_parser_path = m_program_name + " " + parser.m_program_name;
+    ++parser.m_help_revision;
+    auto it = m_subparsers.emplace(std::cend(m_subparsers), parser);
+    m_subparser_map.insert_or_assign(parser.m_program_name, it);
+    m_subparser_used.insert_or_assign(parser.m_program_name, false);
+    m_subcommand_names.clear();
+    ++m_help_revision;
+  }
+
+  using subparser_factory =
+      details::InlineFunction<std::unique_ptr<ArgumentParser>()>;
+
+  /* Register subcommand command, whose parser is only built by factory when
+   * the command is parsed, looked up with at<ArgumentParser>(), or described
+   * by describe(). Until then, help lists the command with description.
+   * factory is called at most once and must return a parser named command,
+   * which this parser then owns.
+   */
+  void add_subparser(std::string command, std::string description,
+                     subparser_factory factory) {
+    add_lazy_subparser(std::move(command), details::Text(std::move(description)),
+                       std::move(factory));
+  }
+
+  void add_subparser(std::string command, StaticText description,
+                     subparser_factory factory) {
+    add_lazy_subparser(std::move(command), details::Text(description),
+                       std::move(factory));
+  }
+
+  void set_suppress(bool suppress) {
+    m_suppress = suppress;
+    ++m_help_revision;
+  }
+
+protected:
+  // The help and usage text of a parser
+  struct HelpTexts {
+    std::shared_ptr<const std::string> usage;
+    std::shared_ptr<const std::string> help;
+  };
+
+  // The texts last rendered, and the revision they render
+  struct RenderedHelp {
+    std::mutex mutex;
+    std::size_t revision = (std::numeric_limits<std::size_t>::max)();
+    HelpTexts texts;
+  };
+
+  /* A subparser, either added as is or registered with a factory that builds
+   * it on first use. Building may happen while the parent is being parsed
+   * with parse() from several threads, so it is done once and published
+   * through an atomic pointer.
+   */
+  class Subcommand {
+  public:
+    explicit Subcommand(ArgumentParser &parser) : m_parser(&parser) {}
+
+    Subcommand(std::string command, std::string parser_path,
+               details::Text description, subparser_factory factory)
+        : m_command(std::move(command)), m_parser_path(std::move(parser_path)),
+          m_description(std::move(description)), m_factory(std::move(factory)) {
+    }
+
+    // The subparser, which is built if it has not been yet
+    ArgumentParser &get() const {
+      if (auto *parser = built()) {
+        return *parser;
+      }
+      std::call_once(m_build_once, [this] { build(); });
+      return *built();
+    }
+
+    // The subparser if it exists already, nullptr otherwise
+    ArgumentParser *built() const {
+      return m_parser.load(std::memory_order_acquire);
+    }
+
+    std::string_view description() const {
+      return m_factory ? m_description.view()
+                       : built()->m_description.view();
+    }
+
+    bool is_suppressed() const { return !m_factory && built()->m_suppress; }
+
+  private:
+    void build() const {
+      auto parser = m_factory();
+      if (parser == nullptr) {
+        throw std::logic_error("Subparser factory of " + m_command +
+                               " returned no parser");
+      }
+      if (parser->m_program_name != m_command) {
+        throw std::logic_error("Subparser factory of " + m_command +
+                               " returned a parser named " +
+                               parser->m_program_name);
+      }
+      parser->m_parser_path = m_parser_path;
+      ++parser->m_help_revision;
+      parser->freeze();
+      m_owned = std::move(parser);
+      m_parser.store(m_owned.get(), std::memory_order_release);
+    }
+
+    std::string m_command;
+    std::string m_parser_path;
+    details::Text m_description;
+    subparser_factory m_factory;
+    mutable std::once_flag m_build_once;
+    mutable std::unique_ptr<ArgumentParser> m_owned;
+    mutable std::atomic<ArgumentParser *> m_parser{nullptr};
+  };
+
+  // Changes of the parser, its arguments, or the subparsers it lists
+  std::size_t help_revision() const {
+    auto revision = m_help_revision + m_default_arguments_help_revision;
+    for (const auto &subparser : m_subparsers) {
+      if (const auto *parser = subparser.built()) {
+        revision += parser->m_help_revision;
+      }
+    }
+    return revision;
+  }
+
+  // Render help and usage again if the parser has changed since last time
+  HelpTexts rendered_help() const;
+
+  void render_usage(std::string &out) const;
+
+  void render_help(std::string &out, std::string_view usage) const;
+
+  // The optional arguments in the group_idx-th group of add_group(), or
+  // before the first group for 0
+  const details::vector<const Argument *> &
+  group_arguments(std::size_t group_idx) const {
+    static const details::vector<const Argument *> none;
+    return group_idx < m_group_arguments.size() ? m_group_arguments[group_idx]
+                                                : none;
+  }
+
+  using tokens_type = details::vector<std::string_view>;
+  using token_iterator = tokens_type::const_iterator;
+
+  /* The tokens of a command line after preprocess_arguments(), with the kind
+   * of each token, so that each token is classified once per parse.
+   */
+  struct ClassifiedTokens {
+    tokens_type views;
+    details::vector<details::token_kind> kinds;
+    // Index of the first option at or after each token, and views.size()
+    std::vector<std::size_t, details::allocator<std::size_t>> next_option;
+
+    explicit ClassifiedTokens(const details::allocator<std::byte> &allocator)
+        : views(allocator), kinds(allocator), next_option(allocator) {}
+
+    details::token_kind kind(token_iterator it) const {
+      return kinds[static_cast<std::size_t>(it - views.begin())];
+    }
+
+    // The end of the values which follow it, before the next option or end
+    token_iterator values_end(token_iterator it, token_iterator end) const {
+      const auto option = views.begin() + static_cast<std::ptrdiff_t>(
+                              next_option[static_cast<std::size_t>(
+                                  it - views.begin())]);
+      return option < end ? option : end;
+    }
+  };
+
+  void parse_args_and_store(const tokens_type &arguments);
+
+  ParseResult parse_args_to_result(const tokens_type &arguments) const;
+
+  std::vector<std::string>
+  parse_known_args_and_store(const tokens_type &arguments);
+
+  ParseResult parse_known_args_to_result(const tokens_type &arguments) const;
+
+  /* Parses into a ParseResult, reporting the first error instead of throwing
+   * it. The index of the offending token is found from its position in the
+   * memory of the tokens, which the preprocessed tokens still point into.
+   */
+  Expected<ParseResult> try_parse_args_to_result(const tokens_type &arguments) const;
+
+  /*
+   * @throws std::runtime_error if the parsed arguments are not valid
+   */
+  void validate(const ParseResult &result, ParseError *error = nullptr) const;
+
+  // At least one argument from the group is required
+  std::string required_group_message(std::size_t group_idx) const;
+
+  void validate_arguments(const ParseResult &result,
+                          ParseError *error = nullptr) const;
+
+  /* @returns true if an error was reported to error, which is then given
+   * token as the offending one unless it already has one
+   */
+  static bool failed(ParseError *error, std::string_view token = {}) {
+    if (error == nullptr || error->m_code == parse_errc{}) {
+      return false;
+    }
+    if (error->m_token.data() == nullptr) {
+      error->m_token = token;
+    }
+    return true;
+  }
+
+  // Store the values recorded in result into the arguments of this parser
+  // and of the subparser that was used, for the non-const getters.
+  void apply_parse_result(ParseResult &&result);
+
+  bool is_valid_prefix_char(char c) const {
+    return m_prefix_char_set.contains(c);
+  }
+
+  /*
+   * The kind of a token, as Argument::is_positional() tells values from
+   * options, with the prefix chars of this parser.
+   */
+  details::token_kind classify(std::string_view token) const {
+    using details::token_kind;
+    if (token.size() < 2 || !is_valid_prefix_char(token[0])) {
+      return token_kind::value;
+    }
+    if (Argument::is_decimal_literal(token.substr(1))) {
+      return token_kind::negative_number;
+    }
+    return is_valid_prefix_char(token[1]) ? token_kind::long_option
+                                          : token_kind::short_option;
+  }
+
+  char get_any_valid_prefix_char() const { return m_prefix_chars[0]; }
+
+  /*
+   * Pre-process this argument list. Anything starting with "--", that
+   * contains an =, where the prefix before the = has an entry in the
+   * options table, should be split. Each token is classified on the way.
+   */
+  ClassifiedTokens
+  preprocess_arguments(token_iterator first, token_iterator last,
+                       const details::allocator<std::byte> &allocator) const;
+
+  /*
+   * @throws std::runtime_error in case of any invalid argument, unless error
+   * is given to report it
+   */
+  void parse_args_internal(token_iterator first, token_iterator last,
+                           ParseResult &result,
+                           ParseError *error = nullptr) const;
+
+  void report_unknown_argument(ParseError *error,
+                               std::string_view token) const {
+    ParseError unknown(parse_errc::unknown_argument, nullptr, {}, token);
+    unknown.m_parser = this;
+    Argument::report_error(error, std::move(unknown));
+  }
+
+  /*
+   * Like parse_args_internal but collects unused args into a vector<string>
+   */
+  std::vector<std::string>
+  parse_known_args_internal(token_iterator first, token_iterator last,
+                            ParseResult &result) const;
+
+  // Used by print_help.
+  std::size_t get_length_of_longest_argument() const;
+
+  using argument_it = details::list<Argument>::iterator;
+  using mutex_group_it = std::vector<MutuallyExclusiveGroup>::iterator;
+  using argument_parser_it = details::list<Subcommand>::iterator;
+
+  void add_lazy_subparser(std::string command, details::Text description,
+                          subparser_factory factory) {
+    auto parser_path = m_program_name + " " + command;
+    auto it = m_subparsers.emplace(std::cend(m_subparsers), command,
+                                   std::move(parser_path),
+                                   std::move(description), std::move(factory));
+    m_subparser_map.insert_or_assign(command, it);
+    m_subparser_used.insert_or_assign(std::move(command), false);
+    m_subcommand_names.clear();
+    ++m_help_revision;
+  }
+
+  // The non-template part of add_argument()
+  Argument &add_argument_names(const std::string_view *names,
+                               std::size_t count);
+
+  void index_argument(argument_it it);
+
+  /* Looks an argument up by name, also as "-name" and "--name" when the name
+   * has no prefix.
+   * @returns nullptr if there is no such argument
+   */
+  Argument *lookup_argument(std::string_view arg_name) const;
+
+  /* Look up an argument by one of its names, in the flat index if the parser
+   * is frozen.
+   * @returns The name as stored in the parser and the argument
+   */
+  std::optional<std::pair<std::string_view, argument_it>>
+  find_argument(std::string_view name) const;
+
+  /* Index the names of the arguments, but not the names offered for unknown
+   * options, which freeze() adds. parse_args() only needs the former, and
+   * builds the suggestions only for an invalid command line.
+   */
+  void index_arguments() {
+    if (m_argument_index.size() != m_argument_map.size()) {
+      m_argument_index.assign(m_argument_map);
+      m_option_names.clear();
+    }
+  }
+
+  void index_all_arguments() {
+    index_arguments();
+    for (auto &subparser : m_subparsers) {
+      if (auto *parser = subparser.built()) {
+        parser->index_all_arguments();
+      }
+    }
+  }
+
+  // Whether this parser has the built-in argument which
+  bool has_default_argument(default_arguments which) const {
+    return (m_default_arguments & which) == which;
+  }
+
+  std::size_t default_argument_count() const {
+    return (has_default_argument(default_arguments::help) ? 1U : 0U) +
+           (has_default_argument(default_arguments::version) ? 1U : 0U);
+  }
+
+  bool is_default_argument_name(std::string_view name) const {
+    return (has_default_argument(default_arguments::help) &&
+            (name == "-h" || name == "--help")) ||
+           (has_default_argument(default_arguments::version) &&
+            (name == "-v" || name == "--version"));
+  }
+
+  /* The built-in -h/--help and -v/--version. They are not built with the
+   * parser but the first time a command line or a lookup names them, or help
+   * lists them, so that a parser which is constructed and parsed without
+   * them does not pay for them. They take the first indices, and are only
+   * found after the arguments of the user, which may reuse their names.
+   */
+  details::list<Argument> &default_argument_list() const;
+
+  // The built-in arguments if they are built already, nullptr otherwise
+  details::list<Argument> *built_default_arguments() const {
+    return m_default_arguments_built.load(std::memory_order_acquire)
+               ? &m_default_argument_list
+               : nullptr;
+  }
+
+  std::optional<std::pair<std::string_view, argument_it>>
+  find_default_argument(std::string_view name) const;
+
+  // The 1-based index of the mutually exclusive group of argument, or 0
+  std::size_t mutex_of(const Argument &argument) const {
+    return argument.m_index < m_mutex_of_argument.size()
+               ? m_mutex_of_argument[argument.m_index]
+               : 0;
+  }
+
+  // The names offered in place of an unknown option: those of the optional
+  // arguments shown in help, without hidden aliases
+  std::vector<std::string_view> suggested_option_names() const;
+
+  // The option closest to an unknown one, or an empty string if none is
+  // close enough to be a likely typo
+  std::string_view similar_option(std::string_view token) const;
+
+  // The subcommand closest to an unknown one, like similar_option()
+  std::string_view similar_subcommand(std::string_view token) const;
+
+  std::string m_program_name;
+  std::string m_version;
+  details::Text m_description;
+  details::Text m_epilog;
+  bool m_exit_on_default_arguments = true;
+  default_arguments m_default_arguments;
+  std::ostream &m_os;
+  std::string m_prefix_chars{"-"};
+  details::CharSet m_prefix_char_set{m_prefix_chars};
+  std::string m_assign_chars{"="};
+  bool m_is_parsed = false;
+  std::string m_parser_path;
+  allocator_type m_allocator;
+  details::list<Argument> m_positional_arguments;
+  details::list<Argument> m_optional_arguments;
+  mutable details::list<Argument> m_default_argument_list;
+  mutable std::once_flag m_default_arguments_once;
+  mutable std::atomic<bool> m_default_arguments_built{false};
+  mutable std::size_t m_default_arguments_help_revision = 0;
+  details::map<std::string, argument_it> m_argument_map;
+  details::FlatNameIndex<argument_it> m_argument_index;
+  details::SimilarityIndex m_option_names;
+  details::list<Subcommand> m_subparsers;
+  details::map<std::string, argument_parser_it> m_subparser_map;
+  details::SimilarityIndex m_subcommand_names;
+  details::map<std::string, bool> m_subparser_used;
+  std::vector<MutuallyExclusiveGroup> m_mutually_exclusive_groups;
+  // Mutually exclusive group of each argument by Argument::m_index, counted
+  // from 1, or 0 if the argument is in none
+  details::vector<std::size_t> m_mutex_of_argument;
+  // Optional arguments of each group, by Argument::m_group_idx
+  details::vector<details::vector<const Argument *>> m_group_arguments;
+  bool m_suppress = false;
+  std::size_t m_usage_max_line_width = (std::numeric_limits<std::size_t>::max)();
+  bool m_usage_break_on_mutex = false;
+  int m_usage_newline_counter = 0;
+  std::vector<details::Text> m_group_names;
+  // Bumped by every change to the parser or its arguments that shows in help
+  std::size_t m_help_revision = 0;
+  mutable RenderedHelp m_rendered_help;
+};
+
+template <char Shape, typename T>
+auto Argument::scan()
+    -> std::enable_if_t<std::is_arithmetic_v<T>, Argument &> {
+  static_assert(!(std::is_const_v<T> || std::is_volatile_v<T>),
+                "T should not be cv-qualified");
+  return typed<T, details::scan_converter<Shape, T>>();
+}
+
+template <typename T> Argument &Argument::type() {
+  static_assert(!(std::is_const_v<T> || std::is_volatile_v<T>),
+                "T should not be cv-qualified");
+  static_assert(std::is_arithmetic_v<T> ||
+                    std::is_constructible_v<T, std::string>,
+                "No conversion from a string to T");
+  return typed<T, details::default_converter<T>>();
+}
+
+template <typename T> T Argument::get(const State &state) const {
+  if (const auto *typed = typed_values_of<T>(state)) {
+    if constexpr (details::IsContainer<T>) {
+      return T(typed->begin(), typed->end());
+    } else {
+      return typed->front();
+    }
+  }
+  if (!state.values.empty()) {
+    if constexpr (details::IsContainer<T>) {
+      return any_cast_container<T>(state.values);
+    } else {
+      return std::any_cast<T>(state.values.front());
+    }
+  }
+  if (m_default_value.has_value()) {
+    return std::any_cast<T>(m_default_value);
+  }
+  if constexpr (details::IsContainer<T>) {
+    if (!m_accepts_optional_like_value) {
+      return any_cast_container<T>(state.values);
+    }
+  }
+
+  throw std::logic_error("No value provided for '" + m_names.back() + "'.");
+}
+
+template <typename T>
+auto Argument::present(const State &state) const -> std::optional<T> {
+  if (m_default_value.has_value()) {
+    throw std::logic_error("Argument with default value always presents");
+  }
+  if (const auto *typed = typed_values_of<T>(state)) {
+    if constexpr (details::IsContainer<T>) {
+      return T(typed->begin(), typed->end());
+    } else {
+      return typed->front();
+    }
+  }
+  if (state.values.empty()) {
+    return std::nullopt;
+  }
+  if constexpr (details::IsContainer<T>) {
+    return any_cast_container<T>(state.values);
+  }
+  return std::any_cast<T>(state.values.front());
+}
+
+template <typename T> T ArgumentParser::get(std::string_view arg_name) const {
+  if (!m_is_parsed) {
+    throw std::logic_error("Nothing parsed, no arguments are available.");
+  }
+  return (*this)[arg_name].get<T>();
+}
+
+template <typename T>
+auto ArgumentParser::present(std::string_view arg_name) const
+    -> std::optional<T> {
+  return (*this)[arg_name].present<T>();
+}
+
+template <typename T> T ParseResult::get(std::string_view arg_name) const {
+  const auto &argument = (*m_parser)[arg_name];
+  return argument.get<T>(state_of(argument));
+}
+
+template <typename T>
+Expected<T> ParseResult::try_get(std::string_view arg_name) const {
+  const auto *argument = m_parser->lookup_argument(arg_name);
+  if (argument == nullptr) {
+    return ParseError(parse_errc::no_such_argument, nullptr, {}, arg_name);
+  }
+  return argument->try_get<T>(state_of(*argument));
+}
+
+template <typename T>
+auto ParseResult::present(std::string_view arg_name) const
+    -> std::optional<T> {
+  const auto &argument = (*m_parser)[arg_name];
+  return argument.present<T>(state_of(argument));
+}
+
+template <typename T>
+const std::vector<T> &
+ParseResult::get_view(std::string_view arg_name) const {
+  const auto &argument = (*m_parser)[arg_name];
+  return argument.get_view<T>(state_of(argument));
+}
+
+#if !defined(ARGPARSE_COMPILED_LIB) || defined(ARGPARSE_IMPLEMENTATION)
+
+ARGPARSE_INLINE std::string ParseError::message() const {
+  if (!m_message.empty()) {
+    return m_message;
+  }
+  switch (m_code) {
+  case parse_errc::unknown_argument:
+    return details::unknown_argument_message(
+        m_token, m_parser != nullptr ? m_parser->similar_option(m_token)
+                                     : std::string_view{});
+  case parse_errc::unknown_subcommand: {
+    auto message = "Failed to parse '" + std::string(m_token) + "'";
+    const auto similar = m_parser->similar_subcommand(m_token);
+    if (!similar.empty()) {
+      message += ", did you mean '" + std::string(similar) + "'";
+    }
+    return message;
+  }
+  case parse_errc::unexpected_positional:
+    if (m_other != nullptr) {
+      return "Zero positional arguments expected, did you mean " +
+             m_other->get_usage_full();
+    }
+    return "Zero positional arguments expected";
+  case parse_errc::too_many_positionals:
+    return "Maximum number of positional arguments exceeded, failed to "
+           "parse '" +
+           std::string(m_token) + "'";
+  case parse_errc::duplicate_argument:
+    return "Duplicate argument " + std::string(m_name);
+  case parse_errc::too_few_values:
+    return "Too few arguments for '" + std::string(m_name) + "'.";
+  case parse_errc::missing_positional:
+    return "Missing " + m_argument->m_names.front();
+  case parse_errc::wrong_number_of_values:
+    return m_argument->nargs_error_message(m_name, m_count);
+  case parse_errc::invalid_choice:
+    return m_argument->invalid_choice_message(m_token);
+  case parse_errc::invalid_value:
+  case parse_errc::value_out_of_range:
+    // The converter gives the message of the value it rejected
+    try {
+      m_convert(m_token);
+    } catch (const std::exception &e) {
+      return e.what();
+    }
+    return "Invalid value: " + std::string(m_token);
+  case parse_errc::required_argument:
+    return m_argument->m_names.front() + ": required.";
+  case parse_errc::missing_value:
+    return std::string(m_name) + ": no value provided.";
+  case parse_errc::mutually_exclusive:
+    return "Argument '" + m_argument->get_usage_full() +
+           "' not allowed with '" + m_other->get_usage_full() + "'";
+  case parse_errc::required_group:
+    return m_parser->required_group_message(m_group);
+  case parse_errc::invalid_default_value:
+    return m_argument->invalid_default_value_message();
+  case parse_errc::no_value:
+    return "No value provided for '" + m_argument->m_names.back() + "'.";
+  case parse_errc::wrong_type:
+    return "Wrong type for '" + m_argument->m_names.back() + "'.";
+  case parse_errc::no_such_argument:
+    return "No such argument: " + std::string(m_token);
+  }
+  return {};
+}
+
+ARGPARSE_INLINE void ParseError::raise() const {
+  switch (m_code) {
+  case parse_errc::invalid_value:
+  case parse_errc::value_out_of_range:
+    if (m_convert != nullptr) {
+      m_convert(m_token);
+    }
+    if (m_code == parse_errc::value_out_of_range) {
+      throw std::range_error(message());
+    }
+    throw std::invalid_argument(message());
+  case parse_errc::no_such_argument:
+  case parse_errc::no_value:
+    throw std::logic_error(message());
+  case parse_errc::wrong_type:
+    throw std::bad_any_cast();
+  default:
+    throw std::runtime_error(message());
+  }
+}
+
+ARGPARSE_INLINE
+ParseResult::ParseResult(const ArgumentParser &parser, bool from_parser_state,
+                         const details::allocator<std::byte> &allocator)
+    : m_parser(&parser), m_states(allocator),
+      m_from_parser_state(from_parser_state) {
+  const auto size = parser.default_argument_count() +
+                    parser.m_positional_arguments.size() +
+                    parser.m_optional_arguments.size();
+  m_states.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    m_states.emplace_back(allocator);
+  }
+  if (m_from_parser_state) {
+    for (const auto *arguments :
+         {&parser.m_positional_arguments, &parser.m_optional_arguments,
+          static_cast<const details::list<Argument> *>(
+              parser.built_default_arguments())}) {
+      if (arguments == nullptr) {
+        continue;
+      }
+      for (const auto &argument : *arguments) {
+        state_of(argument) = argument.m_state;
+      }
+    }
+  }
+}
+
+ARGPARSE_INLINE bool ParseResult::is_used(std::string_view arg_name) const {
+  return state_of((*m_parser)[arg_name]).is_used;
+}
+
+
+ARGPARSE_INLINE Argument::Argument(std::string_view prefix_chars,
+                                   const std::string_view *names,
+                                   std::size_t count)
+    : m_accepts_optional_like_value(false), m_is_optional(false),
+      m_is_required(false), m_is_repeatable(false), m_is_hidden(false),
+      m_prefix_chars(prefix_chars) {
+  m_names.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    m_is_optional = m_is_optional || is_optional(names[i], prefix_chars);
+    m_names.emplace_back(names[i]);
+  }
+  std::sort(
+      m_names.begin(), m_names.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.size() == rhs.size() ? lhs < rhs : lhs.size() < rhs.size();
+      });
+}
+
+ARGPARSE_INLINE bool Argument::is_decimal_literal(std::string_view s) {
+  auto is_digit = [](auto c) constexpr {
+    switch (c) {
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return true;
+    default:
+      return false;
+    }
+  };
+
+  // precondition: we have consumed or will consume at least one digit
+  auto consume_digits = [=](std::string_view sd) {
+    // NOLINTNEXTLINE(readability-qualified-auto)
+    auto it = std::find_if_not(std::begin(sd), std::end(sd), is_digit);
+    return sd.substr(static_cast<std::size_t>(it - std::begin(sd)));
+  };
+
+  switch (lookahead(s)) {
+  case '0': {
+    s.remove_prefix(1);
+    if (s.empty()) {
+      return true;
+    }
+    goto integer_part;
+  }
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9': {
+    s = consume_digits(s);
+    if (s.empty()) {
+      return true;
+    }
+    goto integer_part_consumed;
+  }
+  case '.': {
+    s.remove_prefix(1);
+    goto post_decimal_point;
+  }
+  default:
+    return false;
+  }
+
+integer_part:
+  s = consume_digits(s);
+integer_part_consumed:
+  switch (lookahead(s)) {
+  case '.': {
+    s.remove_prefix(1);
+    if (is_digit(lookahead(s))) {
+      goto post_decimal_point;
+    } else {
+      goto exponent_part_opt;
+    }
+  }
+  case 'e':
+  case 'E': {
+    s.remove_prefix(1);
+    goto post_e;
+  }
+  default:
+    return false;
+  }
+
+post_decimal_point:
+  if (is_digit(lookahead(s))) {
+    s = consume_digits(s);
+    goto exponent_part_opt;
+  }
+  return false;
+
+exponent_part_opt:
+  switch (lookahead(s)) {
+  case eof:
+    return true;
+  case 'e':
+  case 'E': {
+    s.remove_prefix(1);
+    goto post_e;
+  }
+  default:
+    return false;
+  }
+
+post_e:
+  switch (lookahead(s)) {
+  case '-':
+  case '+':
+    s.remove_prefix(1);
+  }
+  if (is_digit(lookahead(s))) {
+    s = consume_digits(s);
+    return s.empty();
+  }
+  return false;
+}
+
+ARGPARSE_INLINE void Argument::validate(const State &state,
+                                        ParseError *error) const {
+  if (m_is_optional) {
+    // TODO: check if an implicit value was programmed for this argument
+    if (!state.is_used && !m_default_value.has_value() && m_is_required) {
+      return report_error(error,
+                          ParseError(parse_errc::required_argument, this));
+    }
+    if (state.is_used && m_is_required && state.size() == 0) {
+      return report_error(error, ParseError(parse_errc::missing_value, this,
+                                            state.used_name));
+    }
+  } else {
+    if (!m_num_args_range.contains(state.size()) &&
+        !m_default_value.has_value()) {
+      ParseError nargs_error(parse_errc::wrong_number_of_values, this,
+                             state.used_name);
+      nargs_error.m_count = state.size();
+      return report_error(error, std::move(nargs_error));
+    }
+  }
+
+  // Make sure the default value (if provided) is in the list of choices
+  if (m_choices.has_value() && !is_default_value_in_choices()) {
+    return report_error(error,
+                        ParseError(parse_errc::invalid_default_value, this));
+  }
+}
+
+ARGPARSE_INLINE std::string Argument::get_usage_full() const {
+  std::string usage = get_names_csv('/');
+  const std::string_view metavar =
+      !m_metavar.empty() ? std::string_view{m_metavar} : "VAR";
+  if (m_num_args_range.get_max() > 0) {
+    usage += ' ';
+    usage += metavar;
+    if (m_num_args_range.get_max() > 1) {
+      usage += "...";
+    }
+  }
+  return usage;
+}
+
+ARGPARSE_INLINE void Argument::append_inline_usage(std::string &out) const {
+  // Find the longest variant to show in the usage string
+  std::string_view longest_name = m_names.front();
+  for (const auto &s : m_names) {
+    if (s.size() > longest_name.size()) {
+      longest_name = s;
+    }
+  }
+  if (!m_is_required) {
+    out += '[';
+  }
+  out += longest_name;
+  const std::string_view metavar =
+      !m_metavar.empty() ? std::string_view{m_metavar} : "VAR";
+  if (m_num_args_range.get_max() > 0) {
+    out += ' ';
+    out += metavar;
+    if (m_num_args_range.get_max() > 1 &&
+        m_metavar.view().find("> <") == std::string_view::npos) {
+      out += "...";
+    }
+  }
+  if (!m_is_required) {
+    out += ']';
+  }
+  if (m_is_repeatable) {
+    out += "...";
+  }
+}
+
+ARGPARSE_INLINE std::size_t Argument::get_arguments_length() const {
+
+  std::size_t names_size = std::accumulate(
+      std::begin(m_names), std::end(m_names), std::size_t(0),
+      [](const auto &sum, const auto &s) { return sum + s.size(); });
+
+  if (is_positional(m_names.front(), m_prefix_chars)) {
+    // A set metavar means this replaces the names
+    if (!m_metavar.empty()) {
+      // Indent and metavar
+      return 2 + m_metavar.size();
+    }
+
+    // Indent and space-separated
+    return 2 + names_size + (m_names.size() - 1);
+  }
+  // Is an option - include both names _and_ metavar
+  // size = text + (", " between names)
+  std::size_t size = names_size + 2 * (m_names.size() - 1);
+  if (!m_metavar.empty() && m_num_args_range == NArgsRange{1, 1}) {
+    size += m_metavar.size() + 1;
+  }
+  return size + 2; // indent
+}
+
+ARGPARSE_INLINE void Argument::append_help(std::string &out,
+                                           std::size_t name_width) const {
+  const auto name_begin = out.size();
+  out += "  "; // indent
+  const auto append_names = [&](std::string_view separator) {
+    for (auto it = m_names.begin(); it != m_names.end(); ++it) {
+      if (it != m_names.begin()) {
+        out += separator;
+      }
+      out += *it;
+    }
+  };
+  if (is_positional(m_names.front(), m_prefix_chars)) {
+    if (!m_metavar.empty()) {
+      out += m_metavar;
+    } else {
+      append_names(" ");
+    }
+  } else {
+    append_names(", ");
+    // If we have a metavar, and one narg - print the metavar
+    if (!m_metavar.empty() && m_num_args_range == NArgsRange{1, 1}) {
+      out += ' ';
+      out += m_metavar;
+    } else if (!m_metavar.empty() && m_num_args_range.is_exact() &&
+               m_metavar.view().find("> <") != std::string_view::npos) {
+      out += ' ';
+      out += m_metavar;
+    }
+  }
+
+  // align multiline help message
+  const auto name_size = out.size() - name_begin;
+  const auto padded_size = std::max(name_size, name_width);
+  out.append(padded_size - name_size, ' ');
+  const auto hspace = "  "; // minimal space between name and help message
+  std::string_view help_view(m_help);
+  auto first_line = true;
+  while (!help_view.empty()) {
+    const auto pos = help_view.find('\n');
+    const auto line = help_view.substr(0, pos == std::string_view::npos
+                                              ? help_view.size()
+                                              : pos + 1);
+    if (!first_line) {
+      out.append(padded_size, ' ');
+    }
+    out += hspace;
+    out += line;
+    first_line = false;
+    help_view.remove_prefix(line.size());
+  }
+  if (first_line) {
+    out += hspace;
+  }
+
+  // print nargs spec
+  if (!m_help.empty()) {
+    out += ' ';
+  }
+  m_num_args_range.append_help(out);
+
+  bool add_space = false;
+  if (m_default_value.has_value() && m_num_args_range != NArgsRange{0, 0}) {
+    out += "[default: ";
+    out += m_default_value_repr;
+    out += ']';
+    add_space = true;
+  } else if (m_is_required) {
+    out += "[required]";
+    add_space = true;
+  }
+  if (m_is_repeatable) {
+    if (add_space) {
+      out += ' ';
+    }
+    out += "[may be repeated]";
+  }
+  out += '\n';
+}
+
+ARGPARSE_INLINE bool Argument::is_positional(std::string_view name,
+                                             std::string_view prefix_chars) {
+  auto first = lookahead(name);
+
+  if (first == eof) {
+    return true;
+  }
+  if (prefix_chars.find(static_cast<char>(first)) !=
+                        std::string_view::npos) {
+    name.remove_prefix(1);
+    if (name.empty()) {
+      return true;
+    }
+    return is_decimal_literal(name);
+  }
+  return true;
+}
+
+ARGPARSE_INLINE std::string
+Argument::nargs_error_message(std::string_view used_name,
+                              std::size_t provided) const {
+  std::stringstream stream;
+  if (!used_name.empty()) {
+    stream << used_name << ": ";
+  } else {
+    stream << m_names.front() << ": ";
+  }
+  if (m_num_args_range.is_exact()) {
+    stream << m_num_args_range.get_min();
+  } else if (m_num_args_range.is_right_bounded()) {
+    stream << m_num_args_range.get_min() << " to "
+           << m_num_args_range.get_max();
+  } else {
+    stream << m_num_args_range.get_min() << " or more";
+  }
+  stream << " argument(s) expected. " << provided << " provided.";
+  return stream.str();
+}
+
+ARGPARSE_INLINE ArgumentParser::operator bool() const {
+  auto arg_used =
+      std::any_of(m_argument_map.cbegin(), m_argument_map.cend(),
+                  [](auto &it) { return it.second->m_state.is_used; });
+  if (const auto *defaults = built_default_arguments()) {
+    arg_used = arg_used ||
+               std::any_of(defaults->cbegin(), defaults->cend(),
+                           [](auto &argument) { return argument.m_state.is_used; });
+  }
+  auto subparser_used =
+      std::any_of(m_subparser_used.cbegin(), m_subparser_used.cend(),
+                  [](auto &it) { return it.second; });
+
+  return m_is_parsed && (arg_used || subparser_used);
+}
+
+ARGPARSE_INLINE ArgumentParser &
+ArgumentParser::add_hidden_alias_for(Argument &arg, std::string_view alias) {
+  for (auto it = m_optional_arguments.begin();
+       it != m_optional_arguments.end(); ++it) {
+    if (&(*it) == &arg) {
+      m_argument_map.insert_or_assign(std::string(alias), it);
+      m_argument_index.clear();
+      m_option_names.clear();
+      ++m_help_revision;
+      return *this;
+    }
+  }
+  throw std::logic_error(
+      "Argument is not an optional argument of this parser");
+}
+
+ARGPARSE_INLINE ArgumentParser &ArgumentParser::freeze() {
+  index_arguments();
+  if (m_option_names.size() == 0) {
+    m_option_names.assign(suggested_option_names());
+  }
+  if (m_subcommand_names.size() != m_subparser_map.size()) {
+    std::vector<std::string_view> commands;
+    commands.reserve(m_subparser_map.size());
+    for ([[maybe_unused]] const auto &[command, unused] : m_subparser_map) {
+      commands.emplace_back(command);
+    }
+    m_subcommand_names.assign(commands);
+  }
+  for (auto &subparser : m_subparsers) {
+    if (auto *parser = subparser.built()) {
+      parser->freeze();
+    }
+  }
+  return *this;
+}
+
+ARGPARSE_INLINE ParserInfo ArgumentParser::describe() const {
+  ParserInfo info;
+  info.program_name = m_program_name;
+  info.path = m_parser_path;
+  info.version = m_version;
+  info.description = m_description;
+  info.epilog = m_epilog;
+  info.usage = usage();
+  info.arguments.resize(default_argument_count() +
+                        m_positional_arguments.size() +
+                        m_optional_arguments.size());
+  const auto describe_argument = [&](const Argument &argument) {
+    auto &argument_info = info.arguments[argument.m_index];
+    argument_info.names.assign(argument.m_names.begin(),
+                               argument.m_names.end());
+    argument_info.help = argument.m_help;
+    argument_info.metavar = argument.m_metavar;
+    argument_info.nargs_min = argument.m_num_args_range.get_min();
+    argument_info.nargs_max = argument.m_num_args_range.get_max();
+    if (argument.m_default_value.has_value()) {
+      argument_info.default_value = argument.m_default_value_repr;
+    }
+    if (argument.m_choices.has_value()) {
+      const auto &choices = argument.m_choices->values();
+      argument_info.choices.assign(choices.begin(), choices.end());
+    }
+    argument_info.is_positional = !argument.m_is_optional;
+    argument_info.is_required = argument.m_is_required;
+    argument_info.is_repeatable = argument.m_is_repeatable;
+    argument_info.is_hidden = argument.m_is_hidden;
+    argument_info.group = argument.m_group_idx;
+    argument_info.mutex_group = mutex_of(argument);
+  };
+  for (const auto &argument : default_argument_list()) {
+    describe_argument(argument);
+  }
+  for (const auto &argument : m_positional_arguments) {
+    describe_argument(argument);
+  }
+  for (const auto &argument : m_optional_arguments) {
+    describe_argument(argument);
+  }
+  info.groups.assign(m_group_names.begin(), m_group_names.end());
+  for (const auto &group : m_mutually_exclusive_groups) {
+    auto &group_info = info.mutex_groups.emplace_back();
+    group_info.is_required = group.m_required;
+    for (const auto *argument : group.m_elements) {
+      group_info.arguments.push_back(argument->m_index);
+    }
+  }
+  for (const auto &[command, subparser] : m_subparser_map) {
+    info.subcommands.push_back({command, subparser->description(),
+                                &subparser->get(),
+                                subparser->is_suppressed()});
+  }
+  return info;
+}
+
+ARGPARSE_INLINE ArgumentParser::HelpTexts
+ArgumentParser::rendered_help() const {
+  const std::lock_guard<std::mutex> lock(m_rendered_help.mutex);
+  const auto revision = help_revision();
+  if (m_rendered_help.revision != revision) {
+    // Holders of the previous texts keep them
+    std::string usage;
+    render_usage(usage);
+    std::string help;
+    render_help(help, usage);
+    m_rendered_help.texts.usage =
+        std::make_shared<const std::string>(std::move(usage));
+    m_rendered_help.texts.help =
+        std::make_shared<const std::string>(std::move(help));
+    m_rendered_help.revision = revision;
+  }
+  return m_rendered_help.texts;
+}
+
+ARGPARSE_INLINE void ArgumentParser::render_usage(std::string &out) const {
+  std::string curline("Usage: ");
+  curline += this->m_parser_path;
+  const bool multiline_usage =
+      this->m_usage_max_line_width < (std::numeric_limits<std::size_t>::max)();
+  const size_t indent_size = curline.size();
+  const auto new_line = [&] {
+    out += curline;
+    out += '\n';
+    curline.assign(indent_size, ' ');
+  };
+
+  std::string arg_inline_usage;
+  const auto deal_with_options_of_group = [&](std::size_t group_idx) {
+    bool found_options = false;
+    // Add any options inline here
+    std::size_t cur_mutex = 0;
+    int usage_newline_counter = -1;
+    const auto render_option = [&](const Argument &argument) {
+      if (argument.m_is_hidden) {
+        return;
+      }
+      if (multiline_usage) {
+        if (usage_newline_counter != argument.m_usage_newline_counter) {
+          if (usage_newline_counter >= 0) {
+            if (curline.size() > indent_size) {
+              new_line();
+            }
+          }
+          usage_newline_counter = argument.m_usage_newline_counter;
+        }
+      }
+      found_options = true;
+      arg_inline_usage.clear();
+      argument.append_inline_usage(arg_inline_usage);
+      const std::size_t arg_mutex = mutex_of(argument);
+      if ((cur_mutex != 0) && (arg_mutex == 0)) {
+        curline += ']';
+        if (this->m_usage_break_on_mutex) {
+          new_line();
+        }
+      } else if ((cur_mutex == 0) && (arg_mutex != 0)) {
+        if ((this->m_usage_break_on_mutex && curline.size() > indent_size) ||
+            curline.size() + 3 + arg_inline_usage.size() >
+                this->m_usage_max_line_width) {
+          new_line();
+        }
+        curline += " [";
+      } else if ((cur_mutex != 0) && (arg_mutex != 0)) {
+        if (cur_mutex != arg_mutex) {
+          curline += ']';
+          if (this->m_usage_break_on_mutex ||
+              curline.size() + 3 + arg_inline_usage.size() >
+                  this->m_usage_max_line_width) {
+            new_line();
+          }
+          curline += " [";
+        } else {
+          curline += '|';
+        }
+      }
+      cur_mutex = arg_mutex;
+      if (curline.size() != indent_size &&
+          curline.size() + 1 + arg_inline_usage.size() >
+          this->m_usage_max_line_width) {
+        new_line();
+        curline += " ";
+      } else if (cur_mutex == 0) {
+        curline += " ";
+      }
+      curline += arg_inline_usage;
+    };
+    if (group_idx == 0) {
+      for (const auto &argument : default_argument_list()) {
+        render_option(argument);
       }
     }
-
     if (multiline_usage) {
-      // Display options of other groups
-      for (std::size_t i = 0; i < m_group_names.size(); ++i) {
-        stream << curline << std::endl << std::endl;
-        stream << m_group_names[i] << ":" << std::endl;
-        curline = std::string(indent_size, ' ');
-        deal_with_options_of_group(i + 1);
+      for (const auto *argument : group_arguments(group_idx)) {
+        render_option(*argument);
+      }
+    } else {
+      for (const auto &argument : this->m_optional_arguments) {
+        render_option(argument);
+      }
+    }
+    if (cur_mutex != 0) {
+      curline += ']';
+    }
+    return found_options;
+  };
+
+  const bool found_options = deal_with_options_of_group(0);
+
+  if (found_options && multiline_usage &&
+      !this->m_positional_arguments.empty()) {
+    new_line();
+  }
+  // Put positional arguments after the optionals
+  for (const auto &argument : this->m_positional_arguments) {
+    if (argument.m_is_hidden) {
+      continue;
+    }
+    const std::string_view pos_arg =
+        !argument.m_metavar.empty() ? argument.m_metavar.view()
+                                    : std::string_view(argument.m_names.front());
+    if (curline.size() + 1 + pos_arg.size() > this->m_usage_max_line_width) {
+      new_line();
+    }
+    curline += " ";
+    if (argument.m_num_args_range.get_min() == 0 &&
+        !argument.m_num_args_range.is_right_bounded()) {
+      curline += "[";
+      curline += pos_arg;
+      curline += "]...";
+    } else if (argument.m_num_args_range.get_min() == 1 &&
+               !argument.m_num_args_range.is_right_bounded()) {
+      curline += pos_arg;
+      curline += "...";
+    } else {
+      curline += pos_arg;
+    }
+  }
+
+  if (multiline_usage) {
+    // Display options of other groups
+    for (std::size_t i = 0; i < m_group_names.size(); ++i) {
+      out += curline;
+      out += "\n\n";
+      out += m_group_names[i];
+      out += ":\n";
+      curline.assign(indent_size, ' ');
+      deal_with_options_of_group(i + 1);
+    }
+  }
+
+  out += curline;
+
+  // Put subcommands after positional arguments
+  if (!m_subparser_map.empty()) {
+    out += " {";
+    std::size_t i{0};
+    for (const auto &[command, subparser] : m_subparser_map) {
+      if (subparser->is_suppressed()) {
+        continue;
+      }
+
+      if (i != 0) {
+        out += ',';
       }
+      out += command;
+      ++i;
     }
+    out += '}';
+  }
+}
 
-    stream << curline;
+ARGPARSE_INLINE void ArgumentParser::render_help(std::string &out,
+                                                 std::string_view usage) const {
+  const auto longest_arg_length = get_length_of_longest_argument();
 
-    // Put subcommands after positional arguments
-    if (!m_subparser_map.empty()) {
-      stream << " {";
-      std::size_t i{0};
-      for (const auto &[command, subparser] : m_subparser_map) {
-        if (subparser->get().m_suppress) {
-          continue;
-        }
+  out += usage;
+  out += "\n\n";
 
-        if (i == 0) {
-          stream << command;
-        } else {
-          stream << "," << command;
+  if (!m_description.empty()) {
+    out += m_description;
+    out += "\n\n";
+  }
+
+  const bool has_visible_positional_args =
+      std::find_if(m_positional_arguments.begin(),
+                   m_positional_arguments.end(), [](const auto &argument) {
+                     return !argument.m_is_hidden;
+                   }) != m_positional_arguments.end();
+  if (has_visible_positional_args) {
+    out += "Positional arguments:\n";
+  }
+
+  for (const auto &argument : m_positional_arguments) {
+    if (!argument.m_is_hidden) {
+      argument.append_help(out, longest_arg_length);
+    }
+  }
+
+  const bool has_optional_args =
+      !m_optional_arguments.empty() || default_argument_count() != 0;
+  if (has_optional_args) {
+    out += !has_visible_positional_args ? "" : "\n";
+    out += "Optional arguments:\n";
+  }
+
+  for (size_t i_group = 0; i_group <= m_group_names.size(); ++i_group) {
+    if (i_group > 0) {
+      out += '\n';
+      out += m_group_names[i_group - 1];
+      out += " (detailed usage):\n";
+    } else {
+      for (const auto &argument : default_argument_list()) {
+        if (!argument.m_is_hidden) {
+          argument.append_help(out, longest_arg_length);
         }
-        ++i;
       }
-      stream << "}";
     }
+    for (const auto *argument : group_arguments(i_group)) {
+      if (!argument->m_is_hidden) {
+        argument->append_help(out, longest_arg_length);
+      }
+    }
+  }
+
+  bool has_visible_subcommands = std::any_of(
+      m_subparser_map.begin(), m_subparser_map.end(),
+      [](auto &p) { return !p.second->is_suppressed(); });
+
+  if (has_visible_subcommands) {
+    out += m_positional_arguments.empty()
+               ? (has_optional_args ? "\n" : "")
+               : "\n";
+    out += "Subcommands:\n";
+    const auto command_width =
+        longest_arg_length > 2 ? longest_arg_length - 2 : 0;
+    for (const auto &[command, subparser] : m_subparser_map) {
+      if (subparser->is_suppressed()) {
+        continue;
+      }
 
-    return stream.str();
+      out += "  ";
+      out += command;
+      if (command.size() < command_width) {
+        out.append(command_width - command.size(), ' ');
+      }
+      out += ' ';
+      out += subparser->description();
+      out += '\n';
+    }
   }
 
-  // Printing the one and only help message
-  // I've stuck with a simple message format, nothing fancy.
-  [[deprecated("Use cout << program; instead.  See also help().")]] std::string
-  print_help() const {
-    auto out = help();
-    std::cout << out.rdbuf();
-    return out.str();
+  if (!m_epilog.empty()) {
+    out += '\n';
+    out += m_epilog;
+    out += "\n\n";
   }
+}
 
-  void add_subparser(ArgumentParser &parser) {
-    parser.m_parser_path = m_program_name + " " + parser.m_program_name;
-    auto it = m_subparsers.emplace(std::cend(m_subparsers), parser);
-    m_subparser_map.insert_or_assign(parser.m_program_name, it);
-    m_subparser_used.insert_or_assign(parser.m_program_name, false);
+ARGPARSE_INLINE void
+ArgumentParser::parse_args_and_store(const tokens_type &arguments) {
+  if (m_program_name.empty() && !arguments.empty()) {
+    m_program_name = arguments.front();
   }
+  index_all_arguments();
+  ParseResult result(*this, true, m_allocator);
+  try {
+    parse_args_internal(arguments.begin(), arguments.end(), result);
+    validate(result);
+  } catch (...) {
+    apply_parse_result(std::move(result));
+    throw;
+  }
+  apply_parse_result(std::move(result));
+}
 
-  void set_suppress(bool suppress) { m_suppress = suppress; }
+ARGPARSE_INLINE ParseResult
+ArgumentParser::parse_args_to_result(const tokens_type &arguments) const {
+  ParseResult result(*this, false, arguments.get_allocator());
+  parse_args_internal(arguments.begin(), arguments.end(), result);
+  validate(result);
+  return result;
+}
 
-protected:
-  const MutuallyExclusiveGroup *get_belonging_mutex(const Argument *arg) const {
-    for (const auto &mutex : m_mutually_exclusive_groups) {
-      if (std::find(mutex.m_elements.begin(), mutex.m_elements.end(), arg) !=
-          mutex.m_elements.end()) {
-        return &mutex;
+ARGPARSE_INLINE std::vector<std::string>
+ArgumentParser::parse_known_args_and_store(const tokens_type &arguments) {
+  if (m_program_name.empty() && !arguments.empty()) {
+    m_program_name = arguments.front();
+  }
+  index_all_arguments();
+  ParseResult result(*this, true, m_allocator);
+  std::vector<std::string> unknown_arguments;
+  try {
+    unknown_arguments = parse_known_args_internal(arguments.begin(),
+                                                  arguments.end(), result);
+    validate_arguments(result);
+  } catch (...) {
+    apply_parse_result(std::move(result));
+    throw;
+  }
+  apply_parse_result(std::move(result));
+  return unknown_arguments;
+}
+
+ARGPARSE_INLINE ParseResult
+ArgumentParser::parse_known_args_to_result(const tokens_type &arguments) const {
+  ParseResult result(*this, false, arguments.get_allocator());
+  result.m_unknown_arguments =
+      parse_known_args_internal(arguments.begin(), arguments.end(), result);
+  validate_arguments(result);
+  return result;
+}
+
+ARGPARSE_INLINE Expected<ParseResult>
+ArgumentParser::try_parse_args_to_result(const tokens_type &arguments) const {
+  ParseResult result(*this, false, arguments.get_allocator());
+  ParseError error;
+  parse_args_internal(arguments.begin(), arguments.end(), result, &error);
+  if (error.m_code == parse_errc{}) {
+    validate(result, &error);
+  }
+  if (error.m_code == parse_errc{}) {
+    return result;
+  }
+  if (error.m_token.data() != nullptr) {
+    const std::less<const char *> before;
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+      const auto *data = arguments[i].data();
+      if (!before(error.m_token.data(), data) &&
+          !before(data + arguments[i].size(),
+                  error.m_token.data() + error.m_token.size())) {
+        error.m_token_index = i;
+        break;
       }
     }
-    return nullptr;
   }
+  return error;
+}
 
-  bool is_valid_prefix_char(char c) const {
-    return m_prefix_chars.find(c) != std::string::npos;
+ARGPARSE_INLINE void ArgumentParser::validate(const ParseResult &result,
+                                              ParseError *error) const {
+  validate_arguments(result, error);
+  if (failed(error)) {
+    return;
   }
 
-  char get_any_valid_prefix_char() const { return m_prefix_chars[0]; }
+  // Check each mutually exclusive group and make sure
+  // there are no constraint violations
+  for (std::size_t group_idx = 0;
+       group_idx < m_mutually_exclusive_groups.size(); ++group_idx) {
+    const auto &group = m_mutually_exclusive_groups[group_idx];
+    auto mutex_argument_used{false};
+    Argument *mutex_argument_it{nullptr};
+    for (Argument *arg : group.m_elements) {
+      if (!mutex_argument_used && result.state_of(*arg).is_used) {
+        mutex_argument_used = true;
+        mutex_argument_it = arg;
+      } else if (mutex_argument_used && result.state_of(*arg).is_used) {
+        // Violation
+        ParseError mutex_error(parse_errc::mutually_exclusive, arg);
+        mutex_error.m_other = mutex_argument_it;
+        return Argument::report_error(error, std::move(mutex_error));
+      }
+    }
 
-  /*
-   * Pre-process this argument list. Anything starting with "--", that
-   * contains an =, where the prefix before the = has an entry in the
-   * options table, should be split.
-   */
-  std::vector<std::string>
-  preprocess_arguments(const std::vector<std::string> &raw_arguments) const {
-    std::vector<std::string> arguments{};
-    for (const auto &arg : raw_arguments) {
-      
-      const auto argument_starts_with_prefix_chars =
-          [this](const std::string &a) -> bool {
-        if (!a.empty()) {
-
-          const auto legal_prefix = [this](char c) -> bool {
-            return m_prefix_chars.find(c) != std::string::npos;
-          };
-
-          // Windows-style
-          // if '/' is a legal prefix char
-          // then allow single '/' followed by argument name, followed by an
-          // assign char, e.g., ':' e.g., 'test.exe /A:Foo'
-          const auto windows_style = legal_prefix('/');
-
-          if (windows_style) {
-            if (legal_prefix(a[0])) {
-              return true;
-            }
-          } else {
-            // Slash '/' is not a legal prefix char
-            // For all other characters, only support long arguments
-            // i.e., the argument must start with 2 prefix chars, e.g,
-            // '--foo' e,g, './test --foo=Bar -DARG=yes'
-            if (a.size() > 1) {
-              return (legal_prefix(a[0]) && legal_prefix(a[1]));
-            }
-          }
-        }
-        return false;
-      };
+    if (!mutex_argument_used && group.m_required) {
+      ParseError group_error(parse_errc::required_group);
+      group_error.m_parser = this;
+      group_error.m_group = group_idx;
+      return Argument::report_error(error, std::move(group_error));
+    }
+  }
+}
+
+ARGPARSE_INLINE std::string
+ArgumentParser::required_group_message(std::size_t group_idx) const {
+  const auto &elements = m_mutually_exclusive_groups[group_idx].m_elements;
+  std::string argument_names{};
+  std::size_t i = 0;
+  std::size_t size = elements.size();
+  for (Argument *arg : elements) {
+    if (i + 1 == size) {
+      // last
+      argument_names += std::string("'") + arg->get_usage_full() + std::string("' ");
+    } else {
+      argument_names += std::string("'") + arg->get_usage_full() + std::string("' or ");
+    }
+    i += 1;
+  }
+  return "One of the arguments " + argument_names + "is required";
+}
+
+ARGPARSE_INLINE void
+ArgumentParser::validate_arguments(const ParseResult &result,
+                                   ParseError *error) const {
+  // Check if all arguments are parsed
+  for ([[maybe_unused]] const auto &[unused, argument] : m_argument_map) {
+    argument->validate(result.state_of(*argument), error);
+    if (failed(error)) {
+      return;
+    }
+  }
+  if (const auto *defaults = built_default_arguments()) {
+    for (const auto &argument : *defaults) {
+      argument.validate(result.state_of(argument), error);
+      if (failed(error)) {
+        return;
+      }
+    }
+  }
+}
+
+ARGPARSE_INLINE void ArgumentParser::apply_parse_result(ParseResult &&result) {
+  for (auto *arguments : {&m_positional_arguments, &m_optional_arguments,
+                          built_default_arguments()}) {
+    if (arguments == nullptr) {
+      continue;
+    }
+    for (auto &argument : *arguments) {
+      argument.m_state = std::move(result.state_of(argument));
+    }
+  }
+  m_is_parsed = m_is_parsed || result.m_is_parsed;
+  if (result.m_subresult != nullptr) {
+    m_subparser_used.find(result.m_subcommand)->second = true;
+    m_subparser_map.find(result.m_subcommand)
+        ->second->get()
+        .apply_parse_result(std::move(*result.m_subresult));
+  }
+}
 
-      // Check that:
-      // - We don't have an argument named exactly this
-      // - The argument starts with a prefix char, e.g., "--"
-      // - The argument contains an assign char, e.g., "="
-      auto assign_char_pos = arg.find_first_of(m_assign_chars);
+ARGPARSE_INLINE ArgumentParser::ClassifiedTokens
+ArgumentParser::preprocess_arguments(
+    token_iterator first, token_iterator last,
+    const details::allocator<std::byte> &allocator) const {
+  using details::token_kind;
+  ClassifiedTokens arguments(allocator);
+  const auto size = static_cast<std::size_t>(std::distance(first, last));
+  arguments.views.reserve(size);
+  arguments.kinds.reserve(size);
+
+  // Windows-style
+  // if '/' is a legal prefix char
+  // then allow single '/' followed by argument name, followed by an
+  // assign char, e.g., ':' e.g., 'test.exe /A:Foo'
+  // For all other prefix chars, only support long arguments
+  // i.e., the argument must start with 2 prefix chars, e.g,
+  // '--foo' e,g, './test --foo=Bar -DARG=yes'
+  const auto windows_style = is_valid_prefix_char('/');
+  // Most parsers have a single assign char, which is found with memchr
+  const auto find_assign_char = [this](std::string_view a) {
+    return m_assign_chars.size() == 1 ? a.find(m_assign_chars.front())
+                                      : a.find_first_of(m_assign_chars);
+  };
 
-      if (m_argument_map.find(arg) == m_argument_map.end() &&
-          argument_starts_with_prefix_chars(arg) &&
-          assign_char_pos != std::string::npos) {
+  for (; first != last; ++first) {
+    const auto arg = *first;
+    const auto kind = classify(arg);
+
+    // Check that:
+    // - The argument starts with a prefix char, e.g., "--"
+    // - We don't have an argument named exactly this
+    // - The argument contains an assign char, e.g., "="
+    const auto may_have_value =
+        windows_style ? kind != token_kind::value
+                      : kind == token_kind::long_option;
+    if (may_have_value) {
+      const auto assign_char_pos = find_assign_char(arg);
+      if (assign_char_pos != std::string_view::npos && !find_argument(arg)) {
         // Get the name of the potential option, and check it exists
-        std::string opt_name = arg.substr(0, assign_char_pos);
-        if (m_argument_map.find(opt_name) != m_argument_map.end()) {
+        const auto opt_name = arg.substr(0, assign_char_pos);
+        if (find_argument(opt_name)) {
           // This is the name of an option! Split it into two parts
-          arguments.push_back(std::move(opt_name));
-          arguments.push_back(arg.substr(assign_char_pos + 1));
+          const auto value = arg.substr(assign_char_pos + 1);
+          arguments.views.push_back(opt_name);
+          arguments.kinds.push_back(classify(opt_name));
+          arguments.views.push_back(value);
+          arguments.kinds.push_back(classify(value));
           continue;
         }
       }
-      // If we've fallen through to here, then it's a standard argument
-      arguments.push_back(arg);
     }
-    return arguments;
+    // If we've fallen through to here, then it's a standard argument
+    arguments.views.push_back(arg);
+    arguments.kinds.push_back(kind);
   }
 
-  /*
-   * @throws std::runtime_error in case of any invalid argument
-   */
-  void parse_args_internal(const std::vector<std::string> &raw_arguments) {
-    auto arguments = preprocess_arguments(raw_arguments);
-    if (m_program_name.empty() && !arguments.empty()) {
-      m_program_name = arguments.front();
-    }
-    auto end = std::end(arguments);
-    auto positional_argument_it = std::begin(m_positional_arguments);
-    for (auto it = std::next(std::begin(arguments)); it != end;) {
-      const auto &current_argument = *it;
-      if (Argument::is_positional(current_argument, m_prefix_chars)) {
-        if (positional_argument_it == std::end(m_positional_arguments)) {
-
-          // Check sub-parsers
-          auto subparser_it = m_subparser_map.find(current_argument);
-          if (subparser_it != m_subparser_map.end()) {
-
-            // build list of remaining args
-            const auto unprocessed_arguments =
-                std::vector<std::string>(it, end);
-
-            // invoke subparser
-            m_is_parsed = true;
-            m_subparser_used[current_argument] = true;
-            return subparser_it->second->get().parse_args(
-                unprocessed_arguments);
+  const auto count = arguments.views.size();
+  arguments.next_option.resize(count + 1);
+  arguments.next_option[count] = count;
+  for (auto i = count; i-- > 0;) {
+    arguments.next_option[i] = details::is_value(arguments.kinds[i])
+                                   ? arguments.next_option[i + 1]
+                                   : i;
+  }
+  return arguments;
+}
+
+ARGPARSE_INLINE void
+ArgumentParser::parse_args_internal(token_iterator first, token_iterator last,
+                                    ParseResult &result,
+                                    ParseError *error) const {
+  const auto tokens =
+      preprocess_arguments(first, last, result.m_states.get_allocator());
+  const auto &arguments = tokens.views;
+  auto end = std::end(arguments);
+  auto positional_argument_it = std::begin(m_positional_arguments);
+  for (auto it = std::next(std::begin(arguments)); it != end;) {
+    const auto current_argument = *it;
+    if (details::is_value(tokens.kind(it))) {
+      if (positional_argument_it == std::end(m_positional_arguments)) {
+
+        // Check sub-parsers
+        auto subparser_it = m_subparser_map.find(current_argument);
+        if (subparser_it != m_subparser_map.end()) {
+
+          // invoke subparser on the remaining args
+          const auto &subparser = subparser_it->second->get();
+          result.m_is_parsed = true;
+          result.m_subcommand = subparser_it->first;
+          result.m_subresult.reset(
+              new ParseResult(subparser, result.m_from_parser_state,
+                              result.m_states.get_allocator()));
+          subparser.parse_args_internal(it, end, *result.m_subresult,
+                                        error);
+          if (!failed(error)) {
+            subparser.validate(*result.m_subresult, error);
           }
+          return;
+        }
 
-          if (m_positional_arguments.empty()) {
-
-            // Ask the user if they argument they provided was a typo
-            // for some sub-parser,
-            // e.g., user provided `git totes` instead of `git notes`
-            if (!m_subparser_map.empty()) {
-              throw std::runtime_error(
-                  "Failed to parse '" + current_argument + "', did you mean '" +
-                  std::string{details::get_most_similar_string(
-                      m_subparser_map, current_argument)} +
-                  "'");
-            }
+        if (m_positional_arguments.empty()) {
+
+          // Ask the user if they argument they provided was a typo
+          // for some sub-parser,
+          // e.g., user provided `git totes` instead of `git notes`
+          if (!m_subparser_map.empty()) {
+            ParseError subcommand_error(parse_errc::unknown_subcommand,
+                                        nullptr, {}, current_argument);
+            subcommand_error.m_parser = this;
+            return Argument::report_error(error,
+                                          std::move(subcommand_error));
+          }
 
-            // Ask the user if they meant to use a specific optional argument
-            if (!m_optional_arguments.empty()) {
-              for (const auto &opt : m_optional_arguments) {
-                if (!opt.m_implicit_value.has_value()) {
-                  // not a flag, requires a value
-                  if (!opt.m_is_used) {
-                    throw std::runtime_error(
-                        "Zero positional arguments expected, did you mean " +
-                        opt.get_usage_full());
-                  }
-                }
+          // Ask the user if they meant to use a specific optional argument
+          ParseError positional_error(parse_errc::unexpected_positional,
+                                      nullptr, {}, current_argument);
+          for (const auto &opt : m_optional_arguments) {
+            if (!opt.m_implicit_value.has_value()) {
+              // not a flag, requires a value
+              if (!result.state_of(opt).is_used) {
+                positional_error.m_other = &opt;
+                break;
               }
-
-              throw std::runtime_error("Zero positional arguments expected");
-            } else {
-              throw std::runtime_error("Zero positional arguments expected");
             }
-          } else {
-            throw std::runtime_error("Maximum number of positional arguments "
-                                     "exceeded, failed to parse '" +
-                                     current_argument + "'");
           }
+          return Argument::report_error(error, std::move(positional_error));
+        } else {
+          return Argument::report_error(
+              error, ParseError(parse_errc::too_many_positionals, nullptr,
+                                {}, current_argument));
         }
-        auto argument = positional_argument_it++;
-
-        // Deal with the situation of <positional_arg1>... <positional_arg2>
-        if (argument->m_num_args_range.get_min() == 1 &&
-            argument->m_num_args_range.get_max() == (std::numeric_limits<std::size_t>::max)() &&
-            positional_argument_it != std::end(m_positional_arguments) &&
-            std::next(positional_argument_it) == std::end(m_positional_arguments) &&
-            positional_argument_it->m_num_args_range.get_min() == 1 &&
-            positional_argument_it->m_num_args_range.get_max() == 1 ) {
-          if (std::next(it) != end) {
-            positional_argument_it->consume(std::prev(end), end);
-            end = std::prev(end);
-          } else {
-            throw std::runtime_error("Missing " + positional_argument_it->m_names.front());
+      }
+      auto argument = positional_argument_it++;
+
+      // Deal with the situation of <positional_arg1>... <positional_arg2>
+      if (argument->m_num_args_range.get_min() == 1 &&
+          argument->m_num_args_range.get_max() == (std::numeric_limits<std::size_t>::max)() &&
+          positional_argument_it != std::end(m_positional_arguments) &&
+          std::next(positional_argument_it) == std::end(m_positional_arguments) &&
+          positional_argument_it->m_num_args_range.get_min() == 1 &&
+          positional_argument_it->m_num_args_range.get_max() == 1 ) {
+        if (std::next(it) != end) {
+          positional_argument_it->consume(
+              std::prev(end), end, tokens.values_end(std::prev(end), end),
+              result.state_of(*positional_argument_it), {}, false, error);
+          if (failed(error, current_argument)) {
+            return;
           }
+          end = std::prev(end);
+        } else {
+          return Argument::report_error(
+              error, ParseError(parse_errc::missing_positional,
+                                &*positional_argument_it));
         }
+      }
 
-        it = argument->consume(it, end);
-        continue;
+      it = argument->consume(it, end, tokens.values_end(it, end),
+                             result.state_of(*argument), {}, false, error);
+      if (failed(error, current_argument)) {
+        return;
       }
+      continue;
+    }
 
-      auto arg_map_it = m_argument_map.find(current_argument);
-      if (arg_map_it != m_argument_map.end()) {
-        auto argument = arg_map_it->second;
-        it = argument->consume(std::next(it), end, arg_map_it->first);
-      } else if (const auto &compound_arg = current_argument;
-                 compound_arg.size() > 1 &&
-                 is_valid_prefix_char(compound_arg[0]) &&
-                 !is_valid_prefix_char(compound_arg[1])) {
-        ++it;
-        for (std::size_t j = 1; j < compound_arg.size(); j++) {
-          auto hypothetical_arg = std::string{'-', compound_arg[j]};
-          auto arg_map_it2 = m_argument_map.find(hypothetical_arg);
-          if (arg_map_it2 != m_argument_map.end()) {
-            auto argument = arg_map_it2->second;
-            it = argument->consume(it, end, arg_map_it2->first);
-          } else {
-            throw std::runtime_error("Unknown argument: " + current_argument);
+    if (auto arg_map_it = find_argument(current_argument)) {
+      auto argument = arg_map_it->second;
+      it = argument->consume(std::next(it), end,
+                             tokens.values_end(std::next(it), end),
+                             result.state_of(*argument), arg_map_it->first,
+                             false, error);
+      if (failed(error, current_argument)) {
+        return;
+      }
+    } else if (tokens.kind(it) == details::token_kind::short_option) {
+      const auto compound_arg = current_argument;
+      ++it;
+      for (std::size_t j = 1; j < compound_arg.size(); j++) {
+        const char hypothetical_chars[] = {'-', compound_arg[j]};
+        const std::string_view hypothetical_arg(hypothetical_chars, 2);
+        if (auto arg_map_it2 = find_argument(hypothetical_arg)) {
+          auto argument = arg_map_it2->second;
+          it = argument->consume(it, end, tokens.values_end(it, end),
+                                 result.state_of(*argument),
+                                 arg_map_it2->first, false, error);
+          if (failed(error, current_argument)) {
+            return;
           }
+        } else {
+          return report_unknown_argument(error, current_argument);
         }
-      } else {
-        throw std::runtime_error("Unknown argument: " + current_argument);
       }
+    } else {
+      return report_unknown_argument(error, current_argument);
     }
-    m_is_parsed = true;
   }
+  result.m_is_parsed = true;
+}
 
-  /*
-   * Like parse_args_internal but collects unused args into a vector<string>
-   */
-  std::vector<std::string>
-  parse_known_args_internal(const std::vector<std::string> &raw_arguments) {
-    auto arguments = preprocess_arguments(raw_arguments);
-
-    std::vector<std::string> unknown_arguments{};
-
-    if (m_program_name.empty() && !arguments.empty()) {
-      m_program_name = arguments.front();
-    }
-    auto end = std::end(arguments);
-    auto positional_argument_it = std::begin(m_positional_arguments);
-    for (auto it = std::next(std::begin(arguments)); it != end;) {
-      const auto &current_argument = *it;
-      if (Argument::is_positional(current_argument, m_prefix_chars)) {
-        if (positional_argument_it == std::end(m_positional_arguments)) {
-
-          // Check sub-parsers
-          auto subparser_it = m_subparser_map.find(current_argument);
-          if (subparser_it != m_subparser_map.end()) {
-
-            // build list of remaining args
-            const auto unprocessed_arguments =
-                std::vector<std::string>(it, end);
-
-            // invoke subparser
-            m_is_parsed = true;
-            m_subparser_used[current_argument] = true;
-            return subparser_it->second->get().parse_known_args_internal(
-                unprocessed_arguments);
-          }
-
-          // save current argument as unknown and go to next argument
-          unknown_arguments.push_back(current_argument);
-          ++it;
-        } else {
-          // current argument is the value of a positional argument
-          // consume it
-          auto argument = positional_argument_it++;
-          it = argument->consume(it, end);
+ARGPARSE_INLINE std::vector<std::string>
+ArgumentParser::parse_known_args_internal(token_iterator first,
+                                          token_iterator last,
+                                          ParseResult &result) const {
+  const auto tokens =
+      preprocess_arguments(first, last, result.m_states.get_allocator());
+  const auto &arguments = tokens.views;
+
+  std::vector<std::string> unknown_arguments{};
+
+  auto end = std::end(arguments);
+  auto positional_argument_it = std::begin(m_positional_arguments);
+  for (auto it = std::next(std::begin(arguments)); it != end;) {
+    const auto current_argument = *it;
+    if (details::is_value(tokens.kind(it))) {
+      if (positional_argument_it == std::end(m_positional_arguments)) {
+
+        // Check sub-parsers
+        auto subparser_it = m_subparser_map.find(current_argument);
+        if (subparser_it != m_subparser_map.end()) {
+
+          // invoke subparser on the remaining args
+          const auto &subparser = subparser_it->second->get();
+          result.m_is_parsed = true;
+          result.m_subcommand = subparser_it->first;
+          result.m_subresult.reset(
+              new ParseResult(subparser, result.m_from_parser_state,
+                              result.m_states.get_allocator()));
+          return subparser.parse_known_args_internal(it, end,
+                                                     *result.m_subresult);
         }
-        continue;
-      }
 
-      auto arg_map_it = m_argument_map.find(current_argument);
-      if (arg_map_it != m_argument_map.end()) {
-        auto argument = arg_map_it->second;
-        it = argument->consume(std::next(it), end, arg_map_it->first);
-      } else if (const auto &compound_arg = current_argument;
-                 compound_arg.size() > 1 &&
-                 is_valid_prefix_char(compound_arg[0]) &&
-                 !is_valid_prefix_char(compound_arg[1])) {
+        // save current argument as unknown and go to next argument
+        unknown_arguments.emplace_back(current_argument);
         ++it;
-        for (std::size_t j = 1; j < compound_arg.size(); j++) {
-          auto hypothetical_arg = std::string{'-', compound_arg[j]};
-          auto arg_map_it2 = m_argument_map.find(hypothetical_arg);
-          if (arg_map_it2 != m_argument_map.end()) {
-            auto argument = arg_map_it2->second;
-            it = argument->consume(it, end, arg_map_it2->first);
-          } else {
-            unknown_arguments.push_back(current_argument);
-            break;
-          }
-        }
       } else {
-        // current argument is an optional-like argument that is unknown
-        // save it and move to next argument
-        unknown_arguments.push_back(current_argument);
-        ++it;
+        // current argument is the value of a positional argument
+        // consume it
+        auto argument = positional_argument_it++;
+        it = argument->consume(it, end, tokens.values_end(it, end),
+                               result.state_of(*argument));
+      }
+      continue;
+    }
+
+    if (auto arg_map_it = find_argument(current_argument)) {
+      auto argument = arg_map_it->second;
+      it = argument->consume(std::next(it), end,
+                             tokens.values_end(std::next(it), end),
+                             result.state_of(*argument), arg_map_it->first);
+    } else if (tokens.kind(it) == details::token_kind::short_option) {
+      const auto compound_arg = current_argument;
+      ++it;
+      for (std::size_t j = 1; j < compound_arg.size(); j++) {
+        const char hypothetical_chars[] = {'-', compound_arg[j]};
+        const std::string_view hypothetical_arg(hypothetical_chars, 2);
+        if (auto arg_map_it2 = find_argument(hypothetical_arg)) {
+          auto argument = arg_map_it2->second;
+          it = argument->consume(it, end, tokens.values_end(it, end),
+                                 result.state_of(*argument),
+                                 arg_map_it2->first);
+        } else {
+          unknown_arguments.emplace_back(current_argument);
+          break;
+        }
       }
+    } else {
+      // current argument is an optional-like argument that is unknown
+      // save it and move to next argument
+      unknown_arguments.emplace_back(current_argument);
+      ++it;
     }
-    m_is_parsed = true;
-    return unknown_arguments;
   }
+  result.m_is_parsed = true;
+  return unknown_arguments;
+}
 
-  // Used by print_help.
-  std::size_t get_length_of_longest_argument() const {
-    if (m_argument_map.empty()) {
-      return 0;
-    }
-    std::size_t max_size = 0;
-    for ([[maybe_unused]] const auto &[unused, argument] : m_argument_map) {
-      max_size =
-          std::max<std::size_t>(max_size, argument->get_arguments_length());
+ARGPARSE_INLINE std::size_t
+ArgumentParser::get_length_of_longest_argument() const {
+  if (m_argument_map.empty() && default_argument_count() == 0) {
+    return 0;
+  }
+  std::size_t max_size = 0;
+  for ([[maybe_unused]] const auto &[unused, argument] : m_argument_map) {
+    max_size =
+        std::max<std::size_t>(max_size, argument->get_arguments_length());
+  }
+  for (const auto &argument : default_argument_list()) {
+    max_size = std::max<std::size_t>(max_size, argument.get_arguments_length());
+  }
+  for ([[maybe_unused]] const auto &[command, unused] : m_subparser_map) {
+    max_size = std::max<std::size_t>(max_size, command.size());
+  }
+  return max_size;
+}
+
+ARGPARSE_INLINE Argument &
+ArgumentParser::add_argument_names(const std::string_view *names,
+                                   std::size_t count) {
+  auto argument = m_optional_arguments.emplace(
+      std::cend(m_optional_arguments), m_prefix_chars, names, count);
+
+  if (!argument->m_is_optional) {
+    m_positional_arguments.splice(std::cend(m_positional_arguments),
+                                  m_optional_arguments, argument);
+  }
+  argument->set_usage_newline_counter(m_usage_newline_counter);
+  argument->set_group_idx(m_group_names.size());
+
+  index_argument(argument);
+  return *argument;
+}
+
+ARGPARSE_INLINE void ArgumentParser::index_argument(argument_it it) {
+  it->set_index(default_argument_count() + m_positional_arguments.size() +
+                m_optional_arguments.size() - 1);
+  for (const auto &name : std::as_const(it->m_names)) {
+    m_argument_map.insert_or_assign(name, it);
+  }
+  m_argument_index.clear();
+  m_option_names.clear();
+  it->m_parser = this;
+  it->m_help_revision = &m_help_revision;
+  ++m_help_revision;
+  m_mutex_of_argument.resize(it->m_index + 1);
+  if (it->m_is_optional) {
+    if (m_group_arguments.size() <= it->m_group_idx) {
+      m_group_arguments.resize(it->m_group_idx + 1);
+    }
+    m_group_arguments[it->m_group_idx].push_back(&*it);
+  }
+}
+
+ARGPARSE_INLINE Argument *
+ArgumentParser::lookup_argument(std::string_view arg_name) const {
+  if (auto found = find_argument(arg_name)) {
+    return &*found->second;
+  }
+  if (!arg_name.empty() && !is_valid_prefix_char(arg_name.front())) {
+    const auto legal_prefix_char = get_any_valid_prefix_char();
+
+    // Build "--" + arg_name on the stack for the common short names
+    std::array<char, 64> buffer{};
+    std::string heap_buffer;
+    char *name = buffer.data();
+    if (arg_name.size() + 2 > buffer.size()) {
+      heap_buffer.resize(arg_name.size() + 2);
+      name = heap_buffer.data();
+    }
+    name[0] = legal_prefix_char;
+    name[1] = legal_prefix_char;
+    std::copy(arg_name.begin(), arg_name.end(), name + 2);
+
+    // "-" + arg_name
+    if (auto found =
+            find_argument(std::string_view(name + 1, arg_name.size() + 1))) {
+      return &*found->second;
+    }
+    // "--" + arg_name
+    if (auto found =
+            find_argument(std::string_view(name, arg_name.size() + 2))) {
+      return &*found->second;
     }
-    for ([[maybe_unused]] const auto &[command, unused] : m_subparser_map) {
-      max_size = std::max<std::size_t>(max_size, command.size());
+  }
+  return nullptr;
+}
+
+ARGPARSE_INLINE auto ArgumentParser::find_argument(std::string_view name) const
+    -> std::optional<std::pair<std::string_view, argument_it>> {
+  if (m_argument_index.size() == m_argument_map.size()) {
+    if (const auto *entry = m_argument_index.find(name)) {
+      return std::make_pair(entry->name, entry->value);
     }
-    return max_size;
+    return find_default_argument(name);
+  }
+  auto it = m_argument_map.find(name);
+  if (it != m_argument_map.end()) {
+    return std::make_pair(std::string_view(it->first), it->second);
   }
+  return find_default_argument(name);
+}
 
-  using argument_it = std::list<Argument>::iterator;
-  using mutex_group_it = std::vector<MutuallyExclusiveGroup>::iterator;
-  using argument_parser_it =
-      std::list<std::reference_wrapper<ArgumentParser>>::iterator;
+ARGPARSE_INLINE details::list<Argument> &
+ArgumentParser::default_argument_list() const {
+  std::call_once(m_default_arguments_once, [this] {
+    if (has_default_argument(default_arguments::help)) {
+      auto &argument = m_default_argument_list.emplace_back(
+          std::string_view("-"),
+          std::array<std::string_view, 2>{"-h", "--help"});
+      argument
+          .action([this](const auto & /*unused*/) {
+            m_os << *this;
+            if (m_exit_on_default_arguments) {
+              std::exit(0);
+            }
+          })
+          .default_value(false)
+          .help(StaticText("shows help message and exits"))
+          .implicit_value(true)
+          .nargs(0);
+    }
+    if (has_default_argument(default_arguments::version)) {
+      auto &argument = m_default_argument_list.emplace_back(
+          std::string_view("-"),
+          std::array<std::string_view, 2>{"-v", "--version"});
+      argument
+          .action([this](const auto & /*unused*/) {
+            m_os << m_version << std::endl;
+            if (m_exit_on_default_arguments) {
+              std::exit(0);
+            }
+          })
+          .default_value(false)
+          .help(StaticText("prints version information and exits"))
+          .implicit_value(true)
+          .nargs(0);
+    }
+    std::size_t index = 0;
+    for (auto &argument : m_default_argument_list) {
+      argument.set_index(index++);
+      argument.m_parser = this;
+      argument.m_help_revision = &m_default_arguments_help_revision;
+    }
+    m_default_arguments_built.store(true, std::memory_order_release);
+  });
+  return m_default_argument_list;
+}
 
-  void index_argument(argument_it it) {
-    for (const auto &name : std::as_const(it->m_names)) {
-      m_argument_map.insert_or_assign(name, it);
+ARGPARSE_INLINE auto ArgumentParser::find_default_argument(std::string_view name) const
+    -> std::optional<std::pair<std::string_view, argument_it>> {
+  if (!is_default_argument_name(name)) {
+    return std::nullopt;
+  }
+  auto &arguments = default_argument_list();
+  for (auto it = arguments.begin(); it != arguments.end(); ++it) {
+    const auto name_it =
+        std::find(it->m_names.begin(), it->m_names.end(), name);
+    if (name_it != it->m_names.end()) {
+      return std::make_pair(std::string_view(*name_it), it);
     }
   }
+  return std::nullopt;
+}
 
-  std::string m_program_name;
-  std::string m_version;
-  std::string m_description;
-  std::string m_epilog;
-  bool m_exit_on_default_arguments = true;
-  std::string m_prefix_chars{"-"};
-  std::string m_assign_chars{"="};
-  bool m_is_parsed = false;
-  std::list<Argument> m_positional_arguments;
-  std::list<Argument> m_optional_arguments;
-  std::map<std::string, argument_it> m_argument_map;
-  std::string m_parser_path;
-  std::list<std::reference_wrapper<ArgumentParser>> m_subparsers;
-  std::map<std::string, argument_parser_it> m_subparser_map;
-  std::map<std::string, bool> m_subparser_used;
-  std::vector<MutuallyExclusiveGroup> m_mutually_exclusive_groups;
-  bool m_suppress = false;
-  std::size_t m_usage_max_line_width = (std::numeric_limits<std::size_t>::max)();
-  bool m_usage_break_on_mutex = false;
-  int m_usage_newline_counter = 0;
-  std::vector<std::string> m_group_names;
-};
+ARGPARSE_INLINE std::vector<std::string_view>
+ArgumentParser::suggested_option_names() const {
+  std::vector<std::string_view> names;
+  for (const auto &[name, argument] : m_argument_map) {
+    const auto &own_names = argument->m_names;
+    if (argument->m_is_optional && !argument->m_is_hidden &&
+        std::find(own_names.begin(), own_names.end(), name) !=
+            own_names.end()) {
+      names.emplace_back(name);
+    }
+  }
+  for (std::string_view name : {"-h", "--help", "-v", "--version"}) {
+    if (is_default_argument_name(name) &&
+        m_argument_map.find(name) == m_argument_map.end()) {
+      names.emplace_back(name);
+    }
+  }
+  return names;
+}
+
+ARGPARSE_INLINE std::string_view
+ArgumentParser::similar_option(std::string_view token) const {
+  const auto max_distance = details::max_typo_distance(token);
+  const auto names =
+      m_argument_index.size() == m_argument_map.size() &&
+              m_option_names.size() != 0
+          ? m_option_names.find(token, max_distance, 1)
+          : details::get_most_similar_strings(
+                suggested_option_names(),
+                [](std::string_view name) { return name; }, token,
+                max_distance, 1);
+  return names.empty() ? std::string_view{} : names.front();
+}
+
+ARGPARSE_INLINE std::string_view
+ArgumentParser::similar_subcommand(std::string_view token) const {
+  const auto max_distance = details::max_typo_distance(token);
+  const auto names =
+      m_subcommand_names.size() == m_subparser_map.size()
+          ? m_subcommand_names.find(token, max_distance, 1)
+          : details::get_most_similar_strings(
+                m_subparser_map,
+                [](const auto &entry) { return std::string_view(entry.first); },
+                token, max_distance, 1);
+  return names.empty() ? std::string_view{} : names.front();
+}
+
+#endif // !defined(ARGPARSE_COMPILED_LIB) || defined(ARGPARSE_IMPLEMENTATION)
+
+#ifdef ARGPARSE_COMPILED_LIB
+// The argparse_lib library also provides the getters and scan<>() for the
+// most common types, which other translation units then do not instantiate
+#ifdef ARGPARSE_IMPLEMENTATION
+#define ARGPARSE_EXTERN_TEMPLATE template
+#else
+#define ARGPARSE_EXTERN_TEMPLATE extern template
+#endif
+
+#define ARGPARSE_EXTERN_GETTERS(T)                                             \
+  ARGPARSE_EXTERN_TEMPLATE T Argument::get<T>(const Argument::State &) const;  \
+  ARGPARSE_EXTERN_TEMPLATE std::optional<T> Argument::present<T>(              \
+      const Argument::State &) const;                                          \
+  ARGPARSE_EXTERN_TEMPLATE T ArgumentParser::get<T>(std::string_view) const;   \
+  ARGPARSE_EXTERN_TEMPLATE std::optional<T> ArgumentParser::present<T>(        \
+      std::string_view) const;                                                 \
+  ARGPARSE_EXTERN_TEMPLATE T ParseResult::get<T>(std::string_view) const;      \
+  ARGPARSE_EXTERN_TEMPLATE std::optional<T> ParseResult::present<T>(           \
+      std::string_view) const
+
+#define ARGPARSE_EXTERN_SCAN(SHAPE, T)                                         \
+  ARGPARSE_EXTERN_TEMPLATE Argument &Argument::scan<SHAPE, T>()
+
+ARGPARSE_EXTERN_GETTERS(std::string);
+ARGPARSE_EXTERN_GETTERS(bool);
+ARGPARSE_EXTERN_GETTERS(int);
+ARGPARSE_EXTERN_GETTERS(long);
+ARGPARSE_EXTERN_GETTERS(long long);
+ARGPARSE_EXTERN_GETTERS(unsigned);
+ARGPARSE_EXTERN_GETTERS(unsigned long);
+ARGPARSE_EXTERN_GETTERS(unsigned long long);
+ARGPARSE_EXTERN_GETTERS(float);
+ARGPARSE_EXTERN_GETTERS(double);
+ARGPARSE_EXTERN_GETTERS(std::vector<std::string>);
+ARGPARSE_EXTERN_GETTERS(std::vector<int>);
+ARGPARSE_EXTERN_GETTERS(std::vector<double>);
+
+ARGPARSE_EXTERN_TEMPLATE Argument &Argument::type<std::string>();
+ARGPARSE_EXTERN_TEMPLATE Argument &Argument::type<int>();
+ARGPARSE_EXTERN_TEMPLATE Argument &Argument::type<double>();
+
+ARGPARSE_EXTERN_SCAN('i', int);
+ARGPARSE_EXTERN_SCAN('d', int);
+ARGPARSE_EXTERN_SCAN('i', long);
+ARGPARSE_EXTERN_SCAN('i', long long);
+ARGPARSE_EXTERN_SCAN('u', unsigned);
+ARGPARSE_EXTERN_SCAN('u', unsigned long);
+ARGPARSE_EXTERN_SCAN('u', unsigned long long);
+ARGPARSE_EXTERN_SCAN('g', float);
+ARGPARSE_EXTERN_SCAN('g', double);
+ARGPARSE_EXTERN_SCAN('f', double);
+
+#undef ARGPARSE_EXTERN_SCAN
+#undef ARGPARSE_EXTERN_GETTERS
+#undef ARGPARSE_EXTERN_TEMPLATE
+#endif // ARGPARSE_COMPILED_LIB
 
 } // namespace argparse
@@ -0,0 +1,635 @@
+/*
+  __ _ _ __ __ _ _ __   __ _ _ __ ___  ___
+ / _` | '__/ _` | '_ \ / _` | '__/ __|/ _ \ Argument Parser for Modern C++
+| (_| | | | (_| | |_) | (_| | |  \__ \  __/ http://github.com/p-ranav/argparse
+ \__,_|_|  \__, | .__/ \__,_|_|  |___/\___|
+           |___/|_|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019-2022 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>
+and other contributors.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <argparse/argparse.hpp>
+
+#ifndef ARGPARSE_MODULE_USE_STD_MODULE
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#endif
+
+namespace argparse {
+
+enum class doc_format { man, markdown, json };
+
+struct DocOptions {
+  doc_format format = doc_format::markdown;
+  // Threads rendering the parsers of the tree, 0 for one per core
+  std::size_t threads = 1;
+  // Also document hidden arguments and suppressed subcommands
+  bool include_hidden = false;
+  // Section of the manual given in the .TH line of a man page
+  std::string_view man_section = "1";
+};
+
+namespace details {
+
+// A parser of the tree being exported, with its rendered text
+struct DocNode {
+  const ArgumentParser *parser = nullptr;
+  std::size_t depth = 0;
+  std::vector<const ArgumentParser *> subcommands; // until they have nodes
+  std::vector<std::size_t> children; // indices of the nodes of subcommands
+  std::string text;
+};
+
+// Call f(i) for each i in [0, count), on up to threads threads
+template <typename F>
+void parallel_for(std::size_t count, std::size_t threads, F &&f) {
+  threads = std::min(threads, count);
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      f(i);
+    }
+    return;
+  }
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  const auto work = [&] {
+    for (auto i = next++; i < count; i = next++) {
+      try {
+        f(i);
+      } catch (...) {
+        const std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = count;
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t i = 1; i < threads; ++i) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+inline void append_joined(std::string &out,
+                          const std::vector<std::string_view> &names,
+                          std::string_view separator) {
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    if (i != 0) {
+      out += separator;
+    }
+    out += names[i];
+  }
+}
+
+// The annotations help shows after the help text of an argument, with
+// the choices of the argument
+inline std::string doc_details(const ArgumentInfo &argument) {
+  std::string details;
+  NArgsRange(argument.nargs_min, argument.nargs_max).append_help(details);
+  const bool takes_values = argument.nargs_max > 0;
+  if (argument.default_value && takes_values) {
+    details += "[default: ";
+    details += *argument.default_value;
+    details += "] ";
+  } else if (argument.is_required) {
+    details += "[required] ";
+  }
+  if (argument.is_repeatable) {
+    details += "[may be repeated] ";
+  }
+  if (!argument.choices.empty()) {
+    details += "[choices: ";
+    append_joined(details, argument.choices, ", ");
+    details += "] ";
+  }
+  if (!details.empty()) {
+    details.pop_back();
+  }
+  return details;
+}
+
+// The names and metavar of an argument as in help, e.g. "-o, --output FILE"
+inline std::string doc_synopsis(const ArgumentInfo &argument) {
+  std::string synopsis;
+  if (argument.is_positional) {
+    if (!argument.metavar.empty()) {
+      synopsis += argument.metavar;
+    } else {
+      append_joined(synopsis, argument.names, " ");
+    }
+  } else {
+    append_joined(synopsis, argument.names, ", ");
+    if (!argument.metavar.empty() && argument.nargs_max > 0) {
+      synopsis += ' ';
+      synopsis += argument.metavar;
+    }
+  }
+  return synopsis;
+}
+
+/* The sections of a parser in help order: positional arguments, optional
+ * arguments outside of groups, then each group. Each holds the indices of
+ * the arguments to document.
+ */
+struct DocSection {
+  std::string_view title;
+  std::vector<std::size_t> arguments;
+};
+
+inline std::vector<DocSection> doc_sections(const ParserInfo &info,
+                                            bool include_hidden) {
+  std::vector<DocSection> sections(info.groups.size() + 2);
+  sections[0].title = "Positional arguments";
+  sections[1].title = "Optional arguments";
+  for (std::size_t i = 0; i < info.groups.size(); ++i) {
+    sections[i + 2].title = info.groups[i];
+  }
+  for (std::size_t i = 0; i < info.arguments.size(); ++i) {
+    const auto &argument = info.arguments[i];
+    if (argument.is_hidden && !include_hidden) {
+      continue;
+    }
+    // Arguments of a parent parser may refer to a group of the parent
+    const auto group = argument.group <= info.groups.size() ? argument.group
+                                                             : 0;
+    auto &section = argument.is_positional ? sections[0]
+                                           : sections[group + 1];
+    section.arguments.push_back(i);
+  }
+  return sections;
+}
+
+// The longest names of the documented arguments of a mutex group
+inline std::vector<std::string_view>
+doc_mutex_names(const ParserInfo &info, const MutexGroupInfo &group,
+                bool include_hidden) {
+  std::vector<std::string_view> names;
+  for (const auto i : group.arguments) {
+    const auto &argument = info.arguments[i];
+    if (!argument.is_hidden || include_hidden) {
+      names.push_back(argument.names.back());
+    }
+  }
+  return names;
+}
+
+inline void append_json_string(std::string &out, std::string_view text) {
+  static constexpr char hex[] = "0123456789abcdef";
+  out += '"';
+  for (const char c : text) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        out += "\\u00";
+        out += hex[static_cast<unsigned char>(c) >> 4];
+        out += hex[static_cast<unsigned char>(c) & 0xf];
+      } else {
+        out += c;
+      }
+    }
+  }
+  out += '"';
+}
+
+inline void append_json_strings(std::string &out,
+                                const std::vector<std::string_view> &texts) {
+  out += '[';
+  for (std::size_t i = 0; i < texts.size(); ++i) {
+    if (i != 0) {
+      out += ',';
+    }
+    append_json_string(out, texts[i]);
+  }
+  out += ']';
+}
+
+// Everything of the object of a parser but the closing "]}" of the list of
+// its subcommands, which are written in between
+inline void render_json(std::string &out, const ParserInfo &info,
+                        const DocOptions &options) {
+  out += "{\"name\":";
+  append_json_string(out, info.program_name);
+  out += ",\"path\":";
+  append_json_string(out, info.path);
+  out += ",\"version\":";
+  append_json_string(out, info.version);
+  out += ",\"description\":";
+  append_json_string(out, info.description);
+  out += ",\"epilog\":";
+  append_json_string(out, info.epilog);
+  out += ",\"usage\":";
+  append_json_string(out, info.usage);
+  out += ",\"arguments\":[";
+  bool first = true;
+  for (const auto &argument : info.arguments) {
+    if (argument.is_hidden && !options.include_hidden) {
+      continue;
+    }
+    out += first ? "{" : ",{";
+    first = false;
+    out += "\"names\":";
+    append_json_strings(out, argument.names);
+    out += ",\"help\":";
+    append_json_string(out, argument.help);
+    out += ",\"metavar\":";
+    append_json_string(out, argument.metavar);
+    out += ",\"nargs\":{\"min\":";
+    out += std::to_string(argument.nargs_min);
+    out += ",\"max\":";
+    out += argument.nargs_max == (std::numeric_limits<std::size_t>::max)()
+               ? "null"
+               : std::to_string(argument.nargs_max);
+    out += "},\"default\":";
+    if (argument.default_value) {
+      append_json_string(out, *argument.default_value);
+    } else {
+      out += "null";
+    }
+    out += ",\"choices\":";
+    append_json_strings(out, argument.choices);
+    out += ",\"positional\":";
+    out += argument.is_positional ? "true" : "false";
+    out += ",\"required\":";
+    out += argument.is_required ? "true" : "false";
+    out += ",\"repeatable\":";
+    out += argument.is_repeatable ? "true" : "false";
+    out += ",\"hidden\":";
+    out += argument.is_hidden ? "true" : "false";
+    out += ",\"group\":";
+    if (argument.group > 0 && argument.group <= info.groups.size()) {
+      append_json_string(out, info.groups[argument.group - 1]);
+    } else {
+      out += "null";
+    }
+    out += '}';
+  }
+  out += "],\"groups\":";
+  append_json_strings(out, info.groups);
+  out += ",\"mutex_groups\":[";
+  for (std::size_t i = 0; i < info.mutex_groups.size(); ++i) {
+    const auto &group = info.mutex_groups[i];
+    out += i == 0 ? "{" : ",{";
+    out += "\"required\":";
+    out += group.is_required ? "true" : "false";
+    out += ",\"arguments\":";
+    append_json_strings(out,
+                        doc_mutex_names(info, group, options.include_hidden));
+    out += '}';
+  }
+  out += "],\"subcommands\":[";
+}
+
+// Text, with every newline followed by indent
+inline void append_indented(std::string &out, std::string_view text,
+                            std::string_view indent) {
+  for (const char c : text) {
+    out += c;
+    if (c == '\n') {
+      out += indent;
+    }
+  }
+}
+
+inline void render_markdown(std::string &out, const ParserInfo &info,
+                            std::size_t depth, const DocOptions &options) {
+  const std::string heading(std::min<std::size_t>(depth + 1, 6), '#');
+  const std::string subheading(std::min<std::size_t>(depth + 2, 6), '#');
+  out += heading;
+  out += ' ';
+  out += info.path;
+  out += "\n\n";
+  if (!info.description.empty()) {
+    out += info.description;
+    out += "\n\n";
+  }
+  out += "```\n";
+  out += info.usage;
+  out += "\n```\n\n";
+
+  for (const auto &section : doc_sections(info, options.include_hidden)) {
+    if (section.arguments.empty()) {
+      continue;
+    }
+    out += subheading;
+    out += ' ';
+    out += section.title;
+    out += "\n\n";
+    for (const auto i : section.arguments) {
+      const auto &argument = info.arguments[i];
+      out += "- `";
+      out += doc_synopsis(argument);
+      out += '`';
+      if (!argument.help.empty()) {
+        out += ": ";
+        append_indented(out, argument.help, "  ");
+      }
+      const auto details = doc_details(argument);
+      if (!details.empty()) {
+        out += ' ';
+        out += details;
+      }
+      out += '\n';
+    }
+    out += '\n';
+  }
+
+  for (const auto &group : info.mutex_groups) {
+    const auto names = doc_mutex_names(info, group, options.include_hidden);
+    if (names.size() < 2) {
+      continue;
+    }
+    out += "Mutually exclusive: `";
+    append_joined(out, names, "`, `");
+    out += group.is_required ? "` (one is required)\n\n" : "`\n\n";
+  }
+
+  bool has_subcommands = false;
+  for (const auto &subcommand : info.subcommands) {
+    if (subcommand.is_hidden && !options.include_hidden) {
+      continue;
+    }
+    if (!has_subcommands) {
+      out += subheading;
+      out += " Subcommands\n\n";
+      has_subcommands = true;
+    }
+    out += "- `";
+    out += subcommand.name;
+    out += '`';
+    if (!subcommand.description.empty()) {
+      out += ": ";
+      out += subcommand.description;
+    }
+    out += '\n';
+  }
+  if (has_subcommands) {
+    out += '\n';
+  }
+
+  if (!info.epilog.empty()) {
+    out += info.epilog;
+    out += "\n\n";
+  }
+}
+
+// Text escaped for roff, so that it is not read as requests or escapes
+inline void append_roff(std::string &out, std::string_view text) {
+  bool line_start = true;
+  for (const char c : text) {
+    if (line_start && (c == '.' || c == '\'')) {
+      out += "\\&";
+    }
+    switch (c) {
+    case '\\':
+      out += "\\e";
+      break;
+    case '-':
+      out += "\\-";
+      break;
+    default:
+      out += c;
+    }
+    line_start = c == '\n';
+  }
+}
+
+inline std::string upper(std::string_view text) {
+  std::string result(text);
+  std::transform(result.begin(), result.end(), result.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+  return result;
+}
+
+inline void render_man(std::string &out, const ParserInfo &info,
+                       std::size_t depth, const DocOptions &options) {
+  const auto section_macro = depth == 0 ? ".SH " : ".SS ";
+  if (depth == 0) {
+    out += ".TH \"";
+    append_roff(out, upper(info.program_name));
+    out += "\" \"";
+    append_roff(out, options.man_section);
+    out += "\" \"\" \"";
+    append_roff(out, info.program_name);
+    out += ' ';
+    append_roff(out, info.version);
+    out += "\"\n.SH NAME\n";
+    append_roff(out, info.program_name);
+    if (!info.description.empty()) {
+      out += " \\- ";
+      append_roff(out, info.description.substr(0, info.description.find('\n')));
+    }
+    out += "\n.SH SYNOPSIS\n";
+  } else {
+    out += ".SH \"";
+    append_roff(out, upper(info.path));
+    out += "\"\n";
+  }
+  out += ".nf\n";
+  append_roff(out, info.usage);
+  out += "\n.fi\n";
+  if (!info.description.empty()) {
+    out += depth == 0 ? ".SH DESCRIPTION\n" : ".PP\n";
+    append_roff(out, info.description);
+    out += '\n';
+  }
+
+  for (const auto &section : doc_sections(info, options.include_hidden)) {
+    if (section.arguments.empty()) {
+      continue;
+    }
+    out += section_macro;
+    out += '"';
+    append_roff(out, depth == 0 ? upper(section.title) : section.title);
+    out += "\"\n";
+    for (const auto i : section.arguments) {
+      const auto &argument = info.arguments[i];
+      out += ".TP\n\\fB";
+      append_roff(out, doc_synopsis(argument));
+      out += "\\fR\n";
+      std::string text(argument.help);
+      const auto details = doc_details(argument);
+      if (!text.empty() && !details.empty()) {
+        text += ' ';
+      }
+      text += details;
+      if (!text.empty()) {
+        append_roff(out, text);
+        out += '\n';
+      }
+    }
+  }
+
+  for (const auto &group : info.mutex_groups) {
+    const auto names = doc_mutex_names(info, group, options.include_hidden);
+    if (names.size() < 2) {
+      continue;
+    }
+    out += ".PP\nMutually exclusive: ";
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      out += i == 0 ? "\\fB" : ", \\fB";
+      append_roff(out, names[i]);
+      out += "\\fR";
+    }
+    out += group.is_required ? " (one is required)\n" : "\n";
+  }
+
+  bool has_subcommands = false;
+  for (const auto &subcommand : info.subcommands) {
+    if (subcommand.is_hidden && !options.include_hidden) {
+      continue;
+    }
+    if (!has_subcommands) {
+      out += section_macro;
+      out += depth == 0 ? "SUBCOMMANDS\n" : "Subcommands\n";
+      has_subcommands = true;
+    }
+    out += ".TP\n\\fB";
+    append_roff(out, subcommand.name);
+    out += "\\fR\n";
+    if (!subcommand.description.empty()) {
+      append_roff(out, subcommand.description);
+      out += '\n';
+    }
+  }
+
+  if (!info.epilog.empty()) {
+    out += ".PP\n";
+    append_roff(out, info.epilog);
+    out += '\n';
+  }
+}
+
+inline void append_doc_tree(std::string &out, std::vector<DocNode> &nodes,
+                            std::size_t i, doc_format format) {
+  out += nodes[i].text;
+  std::string().swap(nodes[i].text);
+  for (std::size_t j = 0; j < nodes[i].children.size(); ++j) {
+    if (format == doc_format::json && j != 0) {
+      out += ',';
+    }
+    append_doc_tree(out, nodes, nodes[i].children[j], format);
+  }
+  if (format == doc_format::json) {
+    out += "]}";
+  }
+}
+
+} // namespace details
+
+/* Document the parser root and all of its subcommands, recursively, as one
+ * man page, one Markdown document or one JSON object. Each parser is
+ * described once. With options.threads other than 1, the parsers of each
+ * level of the tree are rendered in parallel, and the output is the same.
+ * The parsers must not be changed meanwhile.
+ */
+inline std::string export_docs(const ArgumentParser &root,
+                               const DocOptions &options = {}) {
+  const auto threads = options.threads != 0
+                           ? options.threads
+                           : std::max(1U, std::thread::hardware_concurrency());
+  std::vector<details::DocNode> nodes(1);
+  nodes[0].parser = &root;
+
+  std::size_t level_begin = 0;
+  while (level_begin < nodes.size()) {
+    const auto level_end = nodes.size();
+    details::parallel_for(
+        level_end - level_begin, threads, [&](std::size_t offset) {
+          auto &node = nodes[level_begin + offset];
+          const auto info = node.parser->describe();
+          switch (options.format) {
+          case doc_format::man:
+            details::render_man(node.text, info, node.depth, options);
+            break;
+          case doc_format::markdown:
+            details::render_markdown(node.text, info, node.depth, options);
+            break;
+          case doc_format::json:
+            details::render_json(node.text, info, options);
+            break;
+          }
+          for (const auto &subcommand : info.subcommands) {
+            if (!subcommand.is_hidden || options.include_hidden) {
+              node.subcommands.push_back(subcommand.parser);
+            }
+          }
+        });
+    for (auto i = level_begin; i < level_end; ++i) {
+      const auto subcommands = std::move(nodes[i].subcommands);
+      for (const auto *subparser : subcommands) {
+        nodes[i].children.push_back(nodes.size());
+        auto &child = nodes.emplace_back();
+        child.parser = subparser;
+        child.depth = nodes[i].depth + 1;
+      }
+    }
+    level_begin = level_end;
+  }
+
+  std::size_t size = 0;
+  for (const auto &node : nodes) {
+    size += node.text.size() + 3;
+  }
+  std::string out;
+  out.reserve(size);
+  details::append_doc_tree(out, nodes, 0, options.format);
+  return out;
+}
+
+} // namespace argparse
@@ -0,0 +1,763 @@
+/*
+  __ _ _ __ __ _ _ __   __ _ _ __ ___  ___
+ / _` | '__/ _` | '_ \ / _` | '__/ __|/ _ \ Argument Parser for Modern C++
+| (_| | | | (_| | |_) | (_| | |  \__ \  __/ http://github.com/p-ranav/argparse
+ \__,_|_|  \__, | .__/ \__,_|_|  |___/\___|
+           |___/|_|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019-2022 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>
+and other contributors.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <argparse/argparse.hpp>
+
+#ifndef ARGPARSE_MODULE_USE_STD_MODULE
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace argparse {
+
+template <const auto &Schema> class StaticParser;
+
+namespace details {
+
+struct view_string {
+  constexpr auto operator()(std::string_view s) const -> std::string_view {
+    return s;
+  }
+};
+
+// Conversion of the values of a StaticArgument<T, Shape>: like scan<Shape,
+// T>(), or like type<T>() without a Shape. A std::string_view refers to argv.
+template <char Shape, class T> struct static_converter {
+  using type = scan_converter<Shape, T>;
+};
+
+template <class T> struct static_converter<'\0', T> {
+  using type = default_converter<T>;
+};
+
+template <> struct static_converter<'\0', std::string_view> {
+  using type = view_string;
+};
+
+// Tokens of a command line, with room for the value split off an
+// '--option=value' token
+template <typename Token> class StaticTokens {
+public:
+  StaticTokens(const Token *tokens, std::size_t count)
+      : m_tokens(tokens), m_count(count) {}
+
+  std::size_t size() const { return m_count - m_index + (m_has_split ? 1 : 0); }
+
+  bool empty() const { return size() == 0; }
+
+  std::string_view operator[](std::size_t i) const {
+    if (m_has_split) {
+      if (i == 0) {
+        return m_split;
+      }
+      --i;
+    }
+    return std::string_view(m_tokens[m_index + i]);
+  }
+
+  void pop_front() {
+    if (m_has_split) {
+      m_has_split = false;
+    } else {
+      ++m_index;
+    }
+  }
+
+  void push_split(std::string_view value) {
+    m_split = value;
+    m_has_split = true;
+  }
+
+private:
+  const Token *m_tokens;
+  std::size_t m_count;
+  std::size_t m_index = 0;
+  std::string_view m_split;
+  bool m_has_split = false;
+};
+
+} // namespace details
+
+/* An argument of a StaticSchema. T is the type of its values: an arithmetic
+ * type, std::string_view to refer to argv without copies, or any literal type
+ * constructible from a std::string. Shape converts them like scan<Shape, T>().
+ */
+template <typename T, char Shape = '\0'> class StaticArgument {
+  template <typename... Arguments> friend class StaticSchema;
+  template <const auto &Schema> friend class StaticParser;
+
+public:
+  using value_type = T;
+  static constexpr char shape = Shape;
+
+  template <typename... Names>
+  constexpr explicit StaticArgument(Names... names)
+      : m_names{std::string_view(names)...}, m_name_count(sizeof...(Names)) {
+    static_assert(sizeof...(Names) >= 1 && sizeof...(Names) <= max_names,
+                  "An argument has one to four names");
+  }
+
+  constexpr StaticArgument &nargs(std::size_t num_args) {
+    m_num_args_range = details::NArgsRange{num_args, num_args};
+    return *this;
+  }
+
+  constexpr StaticArgument &nargs(std::size_t num_args_min,
+                                  std::size_t num_args_max) {
+    m_num_args_range = details::NArgsRange{num_args_min, num_args_max};
+    return *this;
+  }
+
+  constexpr StaticArgument &nargs(nargs_pattern pattern) {
+    m_num_args_range = details::NArgsRange::of(pattern);
+    return *this;
+  }
+
+  constexpr StaticArgument &default_value(T value) {
+    m_default_value = value;
+    return *this;
+  }
+
+  constexpr StaticArgument &implicit_value(T value) {
+    m_implicit_value = value;
+    m_num_args_range = details::NArgsRange{0, 0};
+    return *this;
+  }
+
+  constexpr StaticArgument &flag() {
+    static_assert(std::is_same_v<T, bool>, "A flag has bool values");
+    default_value(false);
+    return implicit_value(true);
+  }
+
+  constexpr StaticArgument &required() {
+    m_is_required = true;
+    return *this;
+  }
+
+private:
+  static constexpr std::size_t max_names = 4;
+
+  constexpr bool is_optional() const {
+    return m_names[0].size() > 1 && m_names[0][0] == '-';
+  }
+
+  // Whether name is one of the names, with or without its prefix
+  constexpr bool has_name(std::string_view name) const {
+    for (std::size_t i = 0; i < m_name_count; ++i) {
+      auto candidate = m_names[i];
+      if (candidate == name) {
+        return true;
+      }
+      if (!name.empty() && name[0] != '-') {
+        if (candidate.size() > 1 && candidate[0] == '-' &&
+            candidate.substr(1) == name) {
+          return true;
+        }
+        if (candidate.size() > 2 && candidate.substr(0, 2) == "--" &&
+            candidate.substr(2) == name) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  constexpr std::string_view longest_name() const {
+    auto name = m_names[0];
+    for (std::size_t i = 1; i < m_name_count; ++i) {
+      if (m_names[i].size() > name.size()) {
+        name = m_names[i];
+      }
+    }
+    return name;
+  }
+
+  std::array<std::string_view, max_names> m_names;
+  std::size_t m_name_count;
+  details::NArgsRange m_num_args_range{1, 1};
+  std::optional<T> m_default_value;
+  std::optional<T> m_implicit_value;
+  bool m_is_required = false;
+};
+
+/* The arguments of a StaticParser. It must be declared constexpr at namespace
+ * or class scope, to be given to StaticParser by reference.
+ */
+template <typename... Arguments> class StaticSchema {
+  template <const auto &Schema> friend class StaticParser;
+
+public:
+  constexpr explicit StaticSchema(Arguments... arguments)
+      : m_arguments(arguments...) {}
+
+  /* Index of an argument, with or without the prefix of its name, to read
+   * its value from a StaticParser result. Use it in a constant expression
+   * to check the name at compile time.
+   * @throws std::logic_error if there is no such argument
+   */
+  constexpr std::size_t index(std::string_view name) const {
+    std::size_t found = sizeof...(Arguments);
+    for_each([&](std::size_t i, const auto &argument) {
+      if (found == sizeof...(Arguments) && argument.has_name(name)) {
+        found = i;
+      }
+    });
+    if (found == sizeof...(Arguments)) {
+      throw std::logic_error("No such argument: " + std::string(name));
+    }
+    return found;
+  }
+
+  static constexpr std::size_t size() { return sizeof...(Arguments); }
+
+private:
+  template <typename F> constexpr void for_each(F &&f) const {
+    for_each(f, std::index_sequence_for<Arguments...>{});
+  }
+
+  template <typename F, std::size_t... Is>
+  constexpr void for_each(F &f, std::index_sequence<Is...> /*unused*/) const {
+    (f(Is, std::get<Is>(m_arguments)), ...);
+  }
+
+  constexpr std::size_t option_name_count() const {
+    std::size_t count = 0;
+    for_each([&](std::size_t /*unused*/, const auto &argument) {
+      if (argument.is_optional()) {
+        count += argument.m_name_count;
+      }
+    });
+    return count;
+  }
+
+  constexpr std::size_t positional_count() const {
+    std::size_t count = 0;
+    for_each([&](std::size_t /*unused*/, const auto &argument) {
+      if (!argument.is_optional()) {
+        ++count;
+      }
+    });
+    return count;
+  }
+
+  constexpr bool has_valid_names() const {
+    bool valid = true;
+    for_each([&](std::size_t /*unused*/, const auto &argument) {
+      for (std::size_t i = 0; i < argument.m_name_count; ++i) {
+        const auto name = argument.m_names[i];
+        const bool optional = name.size() > 1 && name[0] == '-';
+        if (name.empty() || name == "--" ||
+            optional != argument.is_optional()) {
+          valid = false;
+        }
+      }
+    });
+    return valid;
+  }
+
+  constexpr bool has_unique_names() const {
+    bool unique = true;
+    for_each([&](std::size_t i, const auto &first) {
+      for_each([&](std::size_t j, const auto &second) {
+        for (std::size_t m = 0; m < first.m_name_count; ++m) {
+          for (std::size_t n = 0; n < second.m_name_count; ++n) {
+            if ((i != j || m != n) && first.m_names[m] == second.m_names[n]) {
+              unique = false;
+            }
+          }
+        }
+      });
+    });
+    return unique;
+  }
+
+  constexpr bool has_bounded_nargs() const {
+    bool bounded = true;
+    for_each([&](std::size_t /*unused*/, const auto &argument) {
+      bounded = bounded && argument.m_num_args_range.is_right_bounded();
+    });
+    return bounded;
+  }
+
+  std::tuple<Arguments...> m_arguments;
+};
+
+/* Values of an argument parsed by a StaticParser, stored in place.
+ */
+template <typename T, std::size_t Capacity> class StaticValues {
+  template <const auto &Schema> friend class StaticParser;
+
+public:
+  using value_type = T;
+  using const_iterator = const T *;
+
+  const_iterator begin() const { return m_values.data(); }
+  const_iterator end() const { return m_values.data() + m_size; }
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  const T &operator[](std::size_t i) const { return m_values[i]; }
+  const T &front() const { return m_values[0]; }
+
+private:
+  void push_back(T value) { m_values[m_size++] = std::move(value); }
+
+  std::array<T, Capacity> m_values{};
+  std::size_t m_size = 0;
+};
+
+/* A parser generated at compile time from a StaticSchema. It accepts the
+ * same command lines as an ArgumentParser with the same arguments and
+ * default_arguments::none, without allocating memory unless it throws.
+ *
+ *   constexpr argparse::StaticSchema schema{
+ *       argparse::StaticArgument<int>("-n", "--count"),
+ *       argparse::StaticArgument<bool>("-v", "--verbose").flag(),
+ *       argparse::StaticArgument<std::string_view>("input")};
+ *
+ *   auto result = argparse::StaticParser<schema>::parse_args(argc, argv);
+ *   int count = result.get<schema.index("--count")>();
+ */
+template <const auto &Schema> class StaticParser {
+  using schema_type = std::remove_cv_t<std::remove_reference_t<decltype(Schema)>>;
+
+  static_assert(Schema.has_valid_names(),
+                "Names of an argument are either all optional, starting with "
+                "'-', or all positional");
+  static_assert(Schema.has_unique_names(), "Names of arguments must be unique");
+  static_assert(Schema.has_bounded_nargs(),
+                "Arguments of a StaticParser take a bounded number of values");
+
+  template <std::size_t I>
+  static constexpr const auto &argument = std::get<I>(Schema.m_arguments);
+
+  template <std::size_t I>
+  using argument_type = std::remove_cv_t<std::remove_reference_t<
+      decltype(std::get<I>(Schema.m_arguments))>>;
+
+  template <std::size_t I>
+  using value_type = typename argument_type<I>::value_type;
+
+  template <std::size_t I>
+  static constexpr std::size_t capacity =
+      argument<I>.m_num_args_range.get_max() > 1
+          ? argument<I>.m_num_args_range.get_max()
+          : 1;
+
+  template <std::size_t I>
+  static constexpr bool is_multi_valued =
+      argument<I>.m_num_args_range.get_max() > 1;
+
+  template <std::size_t I> struct Slot {
+    StaticValues<value_type<I>, capacity<I>> values;
+    std::string_view used_name;
+    bool is_used = false;
+  };
+
+  template <typename Indices> struct SlotsOf;
+  template <std::size_t... Is> struct SlotsOf<std::index_sequence<Is...>> {
+    using type = std::tuple<Slot<Is>...>;
+  };
+
+  using Slots =
+      typename SlotsOf<std::make_index_sequence<schema_type::size()>>::type;
+
+  struct NameEntry {
+    std::string_view name;
+    std::size_t argument;
+  };
+
+  static constexpr std::size_t name_count = Schema.option_name_count();
+
+  // Names of optional arguments, sorted by length and then characters
+  static constexpr auto make_names() {
+    std::array<NameEntry, name_count> table{};
+    std::size_t n = 0;
+    Schema.for_each([&](std::size_t index, const auto &arg) {
+      if (arg.is_optional()) {
+        for (std::size_t i = 0; i < arg.m_name_count; ++i) {
+          table[n++] = NameEntry{arg.m_names[i], index};
+        }
+      }
+    });
+    for (std::size_t i = 1; i < name_count; ++i) {
+      for (std::size_t j = i; j > 0; --j) {
+        const auto &a = table[j - 1];
+        const auto &b = table[j];
+        if (a.name.size() < b.name.size() ||
+            (a.name.size() == b.name.size() && a.name <= b.name)) {
+          break;
+        }
+        const auto tmp = table[j - 1];
+        table[j - 1] = table[j];
+        table[j] = tmp;
+      }
+    }
+    return table;
+  }
+
+  static constexpr auto names = make_names();
+
+  static constexpr std::size_t max_name_length =
+      name_count == 0 ? 0 : names[name_count - 1].name.size();
+
+  // names[first_of_length[n]] is the first name of n characters or more
+  static constexpr auto make_first_of_length() {
+    std::array<std::size_t, max_name_length + 2> first{};
+    std::size_t n = 0;
+    for (std::size_t length = 0; length < first.size(); ++length) {
+      while (n < name_count && names[n].name.size() < length) {
+        ++n;
+      }
+      first[length] = n;
+    }
+    return first;
+  }
+
+  static constexpr auto first_of_length = make_first_of_length();
+
+  static constexpr auto make_positionals() {
+    std::array<std::size_t, Schema.positional_count()> indices{};
+    std::size_t n = 0;
+    Schema.for_each([&](std::size_t index, const auto &arg) {
+      if (!arg.is_optional()) {
+        indices[n++] = index;
+      }
+    });
+    return indices;
+  }
+
+  static constexpr auto positionals = make_positionals();
+
+public:
+  class Result {
+    friend class StaticParser;
+
+  public:
+    /* Value of the argument at index I, or its values if it takes more than
+     * one.
+     * @throws std::logic_error if the argument has no value
+     */
+    template <std::size_t I> decltype(auto) get() const {
+      static_assert(I < schema_type::size(), "No such argument");
+      const auto &slot = std::get<I>(m_slots);
+      if constexpr (is_multi_valued<I>) {
+        if (slot.values.empty() && argument<I>.m_default_value) {
+          static const auto default_values = [] {
+            StaticValues<value_type<I>, capacity<I>> values;
+            values.push_back(*argument<I>.m_default_value);
+            return values;
+          }();
+          return (default_values);
+        }
+        return (slot.values);
+      } else {
+        if (!slot.values.empty()) {
+          return slot.values.front();
+        }
+        if (argument<I>.m_default_value) {
+          return *argument<I>.m_default_value;
+        }
+        throw std::logic_error("No value provided for '" +
+                               std::string(argument<I>.longest_name()) +
+                               "'.");
+      }
+    }
+
+    /* Value of the argument at index I if it was given.
+     * @pre The argument has no default value.
+     */
+    template <std::size_t I> auto present() const {
+      static_assert(I < schema_type::size(), "No such argument");
+      static_assert(!argument<I>.m_default_value,
+                    "Argument with default value always presents");
+      using result_type = std::decay_t<decltype(get<I>())>;
+      if (std::get<I>(m_slots).values.empty()) {
+        return std::optional<result_type>();
+      }
+      return std::optional<result_type>(get<I>());
+    }
+
+    template <std::size_t I> bool is_used() const {
+      static_assert(I < schema_type::size(), "No such argument");
+      return std::get<I>(m_slots).is_used;
+    }
+
+    explicit operator bool() const {
+      return std::apply(
+          [](const auto &...slots) { return (slots.is_used || ...); },
+          m_slots);
+    }
+
+  private:
+    Slots m_slots;
+  };
+
+  static Result parse_args(int argc, const char *const argv[]) {
+    return parse(argv, static_cast<std::size_t>(argc));
+  }
+
+  static Result parse_args(std::initializer_list<std::string_view> arguments) {
+    return parse(arguments.begin(), arguments.size());
+  }
+
+  static Result parse_args(const std::vector<std::string> &arguments) {
+    return parse(arguments.data(), arguments.size());
+  }
+
+private:
+  // Dispatch on the length of the name first, then on its characters
+  static const NameEntry *find(std::string_view name) {
+    if (name.size() > max_name_length) {
+      return nullptr;
+    }
+    for (auto i = first_of_length[name.size()],
+              last = first_of_length[name.size() + 1];
+         i < last; ++i) {
+      if (names[i].name == name) {
+        return &names[i];
+      }
+    }
+    return nullptr;
+  }
+
+  // Call f with the argument at index as a compile-time constant
+  template <typename F> static void visit(std::size_t index, F &&f) {
+    visit(index, f, std::make_index_sequence<schema_type::size()>{});
+  }
+
+  template <typename F, std::size_t... Is>
+  static void visit(std::size_t index, F &f,
+                    std::index_sequence<Is...> /*unused*/) {
+    (void)((index == Is ? (f(std::integral_constant<std::size_t, Is>{}), true)
+                        : false) ||
+           ...);
+  }
+
+  template <typename Token>
+  static Result parse(const Token *tokens, std::size_t count) {
+    Result result;
+    details::StaticTokens<Token> stream(tokens, count);
+    if (!stream.empty()) {
+      stream.pop_front();
+    }
+    std::size_t next_positional = 0;
+
+    while (!stream.empty()) {
+      const auto token = stream[0];
+      if (Argument::is_positional(token, "-")) {
+        if (next_positional == positionals.size()) {
+          if (positionals.empty()) {
+            throw std::runtime_error("Zero positional arguments expected");
+          }
+          throw std::runtime_error("Maximum number of positional arguments "
+                                   "exceeded, failed to parse '" +
+                                   std::string(token) + "'");
+        }
+        consume(result, NameEntry{{}, positionals[next_positional++]}, stream);
+        continue;
+      }
+
+      stream.pop_front();
+      if (const auto *entry = find(token)) {
+        consume(result, *entry, stream);
+        continue;
+      }
+
+      if (token.size() > 2 && token[1] == '-') {
+        const auto assign = token.find('=');
+        if (assign != std::string_view::npos) {
+          if (const auto *entry = find(token.substr(0, assign))) {
+            stream.push_split(token.substr(assign + 1));
+            consume(result, *entry, stream);
+            continue;
+          }
+        }
+      } else if (token.size() > 1 && token[1] != '-') {
+        for (std::size_t j = 1; j < token.size(); ++j) {
+          const char hypothetical_chars[] = {'-', token[j]};
+          const auto *entry =
+              find(std::string_view(hypothetical_chars, 2));
+          if (entry == nullptr) {
+            throw_unknown_argument(token);
+          }
+          consume(result, *entry, stream);
+        }
+        continue;
+      }
+      throw_unknown_argument(token);
+    }
+
+    validate(result, std::make_index_sequence<schema_type::size()>{});
+    return result;
+  }
+
+  // Suggests the closest name like ArgumentParser: names at the same distance
+  // are in the order of their characters
+  [[noreturn]] static void throw_unknown_argument(std::string_view token) {
+    const auto max_distance = details::max_typo_distance(token);
+    auto closest = max_distance + 1;
+    std::string_view similar;
+    for (const auto &entry : names) {
+      const auto distance =
+          details::get_levenshtein_distance(entry.name, token, max_distance);
+      if (distance < closest ||
+          (distance == closest && distance <= max_distance &&
+           entry.name < similar)) {
+        closest = distance;
+        similar = entry.name;
+      }
+    }
+    throw std::runtime_error(details::unknown_argument_message(token, similar));
+  }
+
+  // The name in the entry is the one in the schema, which outlives the
+  // command line
+  template <typename Token>
+  static void consume(Result &result, const NameEntry &entry,
+                      details::StaticTokens<Token> &stream) {
+    visit(entry.argument, [&](auto i) {
+      consume<decltype(i)::value>(result, stream, entry.name);
+    });
+  }
+
+  template <std::size_t I, typename Token>
+  static void consume(Result &result, details::StaticTokens<Token> &stream,
+                      std::string_view used_name) {
+    auto &slot = std::get<I>(result.m_slots);
+    const auto &arg = argument<I>;
+    if (slot.is_used) {
+      throw std::runtime_error(
+          std::string("Duplicate argument ").append(used_name));
+    }
+    slot.used_name = used_name;
+
+    if constexpr (arg.m_num_args_range.get_max() == 0) {
+      if (arg.m_implicit_value) {
+        slot.values.push_back(*arg.m_implicit_value);
+      }
+      slot.is_used = true;
+    } else {
+      consume_values<I>(slot, stream, used_name);
+    }
+  }
+
+  template <std::size_t I, typename Token>
+  static void consume_values(Slot<I> &slot,
+                             details::StaticTokens<Token> &stream,
+                             std::string_view used_name) {
+    const auto &arg = argument<I>;
+    constexpr auto num_args_max = arg.m_num_args_range.get_max();
+    constexpr auto num_args_min = arg.m_num_args_range.get_min();
+    auto dist = stream.size();
+    if (dist >= num_args_min) {
+      if (num_args_max < dist) {
+        dist = num_args_max;
+      }
+      for (std::size_t n = 0; n < dist; ++n) {
+        if (!Argument::is_positional(stream[n], "-")) {
+          dist = n;
+        }
+      }
+      if (dist < num_args_min) {
+        throw std::runtime_error("Too few arguments for '" +
+                                 std::string(used_name) + "'.");
+      }
+      using converter =
+          typename details::static_converter<argument_type<I>::shape,
+                                             value_type<I>>::type;
+      for (std::size_t n = 0; n < dist; ++n) {
+        slot.values.push_back(convert<value_type<I>, converter>(stream[0]));
+        stream.pop_front();
+      }
+      slot.is_used = true;
+      return;
+    }
+    if (arg.m_default_value) {
+      slot.is_used = true;
+      return;
+    }
+    throw std::runtime_error("Too few arguments for '" +
+                             std::string(used_name) + "'.");
+  }
+
+  template <typename T, typename Converter>
+  static T convert(std::string_view value) {
+    if constexpr (std::is_invocable_v<Converter, std::string_view>) {
+      return Converter()(value);
+    } else {
+      return Converter()(std::string(value));
+    }
+  }
+
+  template <std::size_t... Is>
+  static void validate(const Result &result,
+                       std::index_sequence<Is...> /*unused*/) {
+    (validate<Is>(result), ...);
+  }
+
+  template <std::size_t I> static void validate(const Result &result) {
+    const auto &slot = std::get<I>(result.m_slots);
+    const auto &arg = argument<I>;
+    if (arg.is_optional()) {
+      if (!slot.is_used && !arg.m_default_value && arg.m_is_required) {
+        throw std::runtime_error(std::string(arg.m_names[0]) + ": required.");
+      }
+      if (slot.is_used && arg.m_is_required && slot.values.empty()) {
+        throw std::runtime_error(std::string(slot.used_name) +
+                                 ": no value provided.");
+      }
+    } else if (!arg.m_num_args_range.contains(slot.values.size()) &&
+               !arg.m_default_value) {
+      std::string message(slot.used_name.empty() ? arg.m_names[0]
+                                                 : slot.used_name);
+      message += ": " + std::to_string(arg.m_num_args_range.get_min());
+      if (!arg.m_num_args_range.is_exact()) {
+        message += " to " + std::to_string(arg.m_num_args_range.get_max());
+      }
+      message += " argument(s) expected. " +
+                 std::to_string(slot.values.size()) + " provided.";
+      throw std::runtime_error(message);
+    }
+  }
+};
+
+} // namespace argparse
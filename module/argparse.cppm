@@ -33,6 +33,8 @@ module;
 
 #ifndef ARGPARSE_MODULE_USE_STD_MODULE
 #include <argparse/argparse.hpp>
+#include <argparse/doc_export.hpp>
+#include <argparse/static_parser.hpp>
 #endif 
 
 export module argparse;
@@ -45,6 +47,8 @@ extern "C++" {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winclude-angled-in-module-purview"
 #include <argparse/argparse.hpp>
+#include <argparse/doc_export.hpp>
+#include <argparse/static_parser.hpp>
 #pragma clang diagnostic pop
 }
 #endif
@@ -55,6 +59,23 @@ export namespace argparse {
     using argparse::default_arguments;
     using argparse::operator&;
     using argparse::Argument;
+    using argparse::ArgHandle;
     using argparse::ArgumentParser;
+    using argparse::ParseResult;
+    using argparse::parse_errc;
+    using argparse::ParseError;
+    using argparse::Expected;
+    using argparse::StaticArgument;
+    using argparse::StaticParser;
+    using argparse::StaticSchema;
+    using argparse::StaticValues;
+    using argparse::StaticText;
+    using argparse::ArgumentInfo;
+    using argparse::MutexGroupInfo;
+    using argparse::SubcommandInfo;
+    using argparse::ParserInfo;
+    using argparse::doc_format;
+    using argparse::DocOptions;
+    using argparse::export_docs;
 }
 
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+
+#include <argparse/argparse.hpp>
+
+#include <cstdint>
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("netconf");
+
+  unsigned retries = 3;
+  long timeout = 30;
+
+  program.add_argument("--port")
+      .help("port to listen on")
+      .scan<'i', int>()
+      .default_value(8080);
+  program.add_argument("--vlan")
+      .help("VLAN id")
+      .scan<'d', std::int16_t>()
+      .default_value(std::int16_t{1});
+  program.add_argument("--mask")
+      .help("interrupt mask, in hexadecimal")
+      .scan<'x', std::uint32_t>()
+      .default_value(std::uint32_t{0xffffffff});
+  program.add_argument("--buffer")
+      .help("buffer size in bytes")
+      .scan<'u', std::uint64_t>()
+      .default_value(std::uint64_t{4096});
+  program.add_argument("--retries")
+      .help("number of retries")
+      .store_into(retries);
+  program.add_argument("--timeout")
+      .help("timeout in seconds")
+      .store_into(timeout);
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::cout << "port " << program.get<int>("--port") << ", vlan "
+            << program.get<std::int16_t>("--vlan") << ", mask " << std::hex
+            << program.get<std::uint32_t>("--mask") << std::dec
+            << ", buffer " << program.get<std::uint64_t>("--buffer")
+            << ", retries " << retries << ", timeout " << timeout
+            << std::endl;
+}
@@ -0,0 +1,8 @@
+// The non-template core of argparse, compiled once into the argparse_lib
+// library. The translation units which use the library are compiled with
+// ARGPARSE_COMPILED_LIB, as the CMake and Bazel targets do.
+#ifndef ARGPARSE_COMPILED_LIB
+#define ARGPARSE_COMPILED_LIB
+#endif
+#define ARGPARSE_IMPLEMENTATION
+#include <argparse/argparse.hpp>
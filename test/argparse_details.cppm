@@ -6,5 +6,9 @@ export module argparse.details;
 
 export namespace argparse::details {
     using argparse::details::repr;
+    using argparse::details::get_levenshtein_distance;
+    using argparse::details::get_most_similar_strings;
+    using argparse::details::get_most_similar_string;
+    using argparse::details::SimilarityIndex;
 }
 
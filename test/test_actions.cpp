@@ -5,6 +5,10 @@ import argparse;
 #endif
 #include <doctest.hpp>
 
+#include <array>
+#include <string>
+#include <vector>
+
 using doctest::test_suite;
 
 TEST_CASE("Users can use default value inside actions" *
@@ -200,3 +204,36 @@ TEST_CASE("Users can add multiple actions and they are all run" *
     }
   }
 }
+
+TEST_CASE("Actions keep their state and bound arguments when copied" *
+          test_suite("actions")) {
+  argparse::ArgumentParser parent("parent", "1.0",
+                                  argparse::default_arguments::none);
+  std::vector<std::string> seen;
+  // Too large to be stored in place
+  const std::array<int, 16> offsets{100};
+  parent.add_argument("--value")
+      .action(
+          [](const std::array<int, 16> &bound, const std::string &value) {
+            return bound[0] + std::stoi(value);
+          },
+          offsets)
+      .append();
+  parent.add_argument("--seen")
+      .action([&seen, calls = 0](const std::string &value) mutable {
+        seen.push_back(value + std::to_string(++calls));
+      })
+      .append();
+
+  argparse::ArgumentParser program("test");
+  program.add_parents(parent);
+  program.parse_args(
+      {"test", "--value", "1", "--seen", "1", "--value", "2", "--seen", "2"});
+  REQUIRE(program.get<std::vector<int>>("--value") ==
+          std::vector<int>{101, 102});
+  REQUIRE(seen == std::vector<std::string>{"11", "22"});
+
+  parent.parse_args({"parent", "--value", "3", "--seen", "3"});
+  REQUIRE(parent.get<std::vector<int>>("--value") == std::vector<int>{103});
+  REQUIRE(seen.back() == "31");
+}
@@ -0,0 +1,111 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/argparse.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using doctest::test_suite;
+
+TEST_CASE("Read values through handles" * test_suite("ArgHandle")) {
+  argparse::ArgumentParser program("test");
+  auto count = program.add_argument("--count")
+                   .scan<'i', int>()
+                   .default_value(1)
+                   .handle<int>();
+  auto name = program.add_argument("--name").handle<std::string>();
+  auto files = program.add_argument("files")
+                   .remaining()
+                   .handle<std::vector<std::string>>();
+
+  program.parse_args({"test", "--count", "3", "a", "b"});
+
+  REQUIRE(count.get() == 3);
+  REQUIRE(count.is_used());
+  REQUIRE_FALSE(name.is_used());
+  REQUIRE(name.present() == std::nullopt);
+  REQUIRE_THROWS_AS(name.get(), std::logic_error);
+  REQUIRE(files.get() == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("Read a default value through a handle" * test_suite("ArgHandle")) {
+  argparse::ArgumentParser program("test");
+  auto verbose = program.add_argument("--verbose").flag().handle<bool>();
+
+  program.parse_args({"test"});
+
+  REQUIRE(verbose.get() == false);
+  REQUIRE_FALSE(verbose.is_used());
+}
+
+TEST_CASE("Read the results of parse() through handles" *
+          test_suite("ArgHandle")) {
+  argparse::ArgumentParser program("test");
+  auto level = program.add_argument("-l", "--level")
+                   .scan<'i', int>()
+                   .default_value(0)
+                   .handle<int>();
+  auto output = program.add_argument("-o").handle<std::string>();
+
+  auto first = program.parse({"test", "-l", "2", "-o", "out"});
+  auto second = program.parse({"test"});
+
+  REQUIRE(level.get(first) == 2);
+  REQUIRE(level.is_used(first));
+  REQUIRE(output.present(first) == "out");
+  REQUIRE(level.get(second) == 0);
+  REQUIRE_FALSE(level.is_used(second));
+  REQUIRE(output.present(second) == std::nullopt);
+}
+
+TEST_CASE("Read through a handle of the wrong type" *
+          test_suite("ArgHandle")) {
+  argparse::ArgumentParser program("test");
+  auto count = program.add_argument("--count").handle<int>();
+
+  program.parse_args({"test", "--count", "3"});
+
+  REQUIRE_THROWS_AS(count.get(), std::bad_any_cast);
+}
+
+TEST_CASE("Read typed values through handles" * test_suite("ArgHandle")) {
+  argparse::ArgumentParser program("test");
+  auto sizes = program.add_argument("--sizes")
+                   .scan<'i', int>()
+                   .nargs(argparse::nargs_pattern::any)
+                   .handle<std::vector<int>>();
+  auto first = program["--sizes"].handle<int>();
+  auto ratio =
+      program.add_argument("--ratio").scan<'g', double>().handle<double>();
+
+  program.parse_args({"test", "--sizes", "1", "2", "3"});
+
+  REQUIRE(sizes.get() == std::vector<int>{1, 2, 3});
+  REQUIRE(first.get() == 1);
+  REQUIRE(first.present() == 1);
+  REQUIRE(ratio.present() == std::nullopt);
+  REQUIRE_THROWS_AS(ratio.get(), std::logic_error);
+  REQUIRE_THROWS_AS(program["--sizes"].handle<long>(), std::bad_any_cast);
+  REQUIRE_THROWS_AS(program["--sizes"].handle<std::vector<long>>(),
+                    std::bad_any_cast);
+}
+
+TEST_CASE("Read the result of another parser through a handle" *
+          test_suite("ArgHandle")) {
+  argparse::ArgumentParser first("first");
+  auto number = first.add_argument("--n").handle<std::string>();
+  argparse::ArgumentParser second("second");
+  second.add_argument("--s");
+
+  auto result = second.parse({"second", "--s", "hello"});
+
+  REQUIRE_THROWS_WITH_AS(number.get(result),
+                         "Result of another parser given for '--n'.",
+                         std::logic_error);
+  REQUIRE_THROWS_AS(number.present(result), std::logic_error);
+  REQUIRE_THROWS_AS(number.is_used(result), std::logic_error);
+}
@@ -6,6 +6,9 @@ import argparse;
 
 #include <doctest.hpp>
 
+#include <string>
+#include <vector>
+
 using doctest::test_suite;
 
 TEST_CASE("Parse argument that is provided zero choices" *
@@ -110,7 +113,8 @@ TEST_CASE("Parse invalid argument that is not in the fixed number of allowed "
 
   REQUIRE_THROWS_WITH_AS(
       program.parse_args({"test", "red2"}),
-      "Invalid argument \"red2\" - allowed options: {red, green, blue}",
+      "Invalid argument \"red2\" - allowed options: {red, green, blue}, did "
+      "you mean \"red\"",
       std::runtime_error);
 }
 
@@ -131,7 +135,8 @@ TEST_CASE("Parse multiple arguments one of which is not in the fixed number of "
 
   REQUIRE_THROWS_WITH_AS(
       program.parse_args({"test", "red", "green2"}),
-      "Invalid argument \"green2\" - allowed options: {red, green, blue}",
+      "Invalid argument \"green2\" - allowed options: {red, green, blue}, "
+      "did you mean \"green\"",
       std::runtime_error);
 }
 
@@ -203,3 +208,65 @@ TEST_CASE("Parse multiple arguments that are not in range of allowed choices" *
       "Invalid argument \"d\" - allowed options: {a, b, c}",
       std::runtime_error);
 }
+
+TEST_CASE("Parse arguments with many allowed choices" * test_suite("choices")) {
+  std::vector<std::string> tenants;
+  for (int i = 0; i < 20000; ++i) {
+    tenants.push_back("tenant-" + std::to_string(i));
+  }
+  argparse::ArgumentParser program("test");
+  auto &argument = program.add_argument("--tenant").nargs(1, 3);
+  for (const auto &tenant : tenants) {
+    argument.add_choice(tenant);
+  }
+  argument.choices("admin", 0);
+
+  auto result =
+      program.parse({"test", "--tenant", "tenant-19999", "admin", "0"});
+  REQUIRE(result.get<std::vector<std::string>>("--tenant") ==
+          std::vector<std::string>{"tenant-19999", "admin", "0"});
+
+  REQUIRE_THROWS_WITH_AS(
+      program.parse({"test", "--tenant", "tenant-20000"}),
+      doctest::Contains("Invalid argument \"tenant-20000\" - allowed options: "
+                        "{tenant-0, tenant-1, "),
+      std::runtime_error);
+}
+
+TEST_CASE("Parent parsers keep the choices of their arguments" *
+          test_suite("choices")) {
+  argparse::ArgumentParser parent("parent", "1.0",
+                                  argparse::default_arguments::none);
+  parent.add_argument("--color").choices("red", "green").choices("blue");
+
+  argparse::ArgumentParser program("test");
+  program.add_parents(parent);
+
+  REQUIRE(program.parse({"test", "--color", "blue"}).get("--color") ==
+          "blue");
+  REQUIRE_THROWS_WITH_AS(
+      program.parse({"test", "--color", "yellow"}),
+      "Invalid argument \"yellow\" - allowed options: {red, green, blue}",
+      std::runtime_error);
+}
+
+TEST_CASE("Suggest the closest of many choices" * test_suite("choices")) {
+  argparse::ArgumentParser program("test");
+  auto &argument = program.add_argument("--tenant");
+  for (int i = 0; i < 20000; ++i) {
+    argument.add_choice("tenant-" + std::to_string(i));
+  }
+  argument.choices();
+
+  REQUIRE_THROWS_WITH_AS(
+      program.parse({"test", "--tenant", "tenat-12345"}),
+      doctest::Contains("}, did you mean \"tenant-12345\""),
+      std::runtime_error);
+  // Too far from any choice to be a typo
+  try {
+    program.parse({"test", "--tenant", "admin"});
+    FAIL("admin is not a choice");
+  } catch (const std::runtime_error &e) {
+    REQUIRE(std::string(e.what()).find("did you mean") == std::string::npos);
+  }
+}
@@ -8,6 +8,8 @@ import argparse;
 #include <iostream>
 #include <sstream>
 #include <streambuf>
+#include <string_view>
+#include <vector>
 
 using doctest::test_suite;
 
@@ -35,3 +37,37 @@ TEST_CASE("Do not exit on default arguments" * test_suite("default_args")) {
   std::cout.rdbuf(saved_cout_buf);
   REQUIRE(parser.is_used("--help"));
 }
+
+TEST_CASE("Default arguments are available when not given" *
+          test_suite("default_args")) {
+  argparse::ArgumentParser parser("test", "1.0",
+                                  argparse::default_arguments::all, false);
+  parser.add_argument("--count").scan<'i', int>().default_value(1);
+  parser.parse_args({"test", "--count", "2"});
+  REQUIRE(parser.get<int>("--count") == 2);
+  REQUIRE(parser.get<bool>("--help") == false);
+  REQUIRE_FALSE(parser.is_used("-v"));
+  REQUIRE(parser.usage() == "Usage: test [--help] [--version] [--count VAR]");
+
+  const auto info = parser.describe();
+  REQUIRE(info.arguments.size() == 3);
+  REQUIRE(info.arguments[0].names == std::vector<std::string_view>{"-h", "--help"});
+  REQUIRE(info.arguments[2].names == std::vector<std::string_view>{"--count"});
+}
+
+TEST_CASE("Default arguments in combined and mistyped options" *
+          test_suite("default_args")) {
+  std::stringstream out;
+  argparse::ArgumentParser parser("test", "2.5",
+                                  argparse::default_arguments::all, false, out);
+  parser.add_argument("-q").flag();
+
+  parser.parse_args({"test", "-qv"});
+  REQUIRE(parser.get<bool>("-q"));
+  REQUIRE(parser.is_used("--version"));
+  REQUIRE(out.str() == "2.5\n");
+
+  REQUIRE_THROWS_WITH_AS(parser.parse({"test", "--hepl"}),
+                         "Unknown argument: --hepl, did you mean '--help'",
+                         std::runtime_error);
+}
@@ -0,0 +1,140 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/doc_export.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using doctest::test_suite;
+
+namespace {
+bool contains(std::string_view haystack, std::string_view needle) {
+  return haystack.find(needle) != std::string_view::npos;
+}
+} // namespace
+
+TEST_CASE("describe() reports what help shows" * test_suite("doc_export")) {
+  argparse::ArgumentParser program("test", "1.0",
+                                   argparse::default_arguments::none);
+  program.add_argument("input").help("the input");
+  program.add_group("Output");
+  auto &group = program.add_mutually_exclusive_group(true);
+  group.add_argument("-q", "--quiet").flag();
+  group.add_argument("--level").choices("low", "high").default_value(
+      std::string("low"));
+  program.add_argument("--secret").hidden();
+  argparse::ArgumentParser command("run");
+  command.add_description("runs it");
+  program.add_subparser(command);
+
+  const auto info = program.describe();
+  REQUIRE(info.program_name == "test");
+  REQUIRE(info.usage == program.usage());
+  REQUIRE(info.arguments.size() == 4);
+  REQUIRE(info.arguments[0].names == std::vector<std::string_view>{"input"});
+  REQUIRE(info.arguments[0].help == "the input");
+  REQUIRE(info.arguments[0].is_positional);
+  REQUIRE(info.arguments[1].names ==
+          std::vector<std::string_view>{"-q", "--quiet"});
+  REQUIRE(info.arguments[1].nargs_max == 0);
+  REQUIRE(info.arguments[1].group == 1);
+  REQUIRE(info.arguments[1].mutex_group == 1);
+  REQUIRE(info.arguments[2].choices ==
+          std::vector<std::string_view>{"low", "high"});
+  REQUIRE(info.arguments[2].default_value == "\"low\"");
+  REQUIRE(info.arguments[3].is_hidden);
+  REQUIRE(info.arguments[3].mutex_group == 0);
+  REQUIRE(info.groups == std::vector<std::string_view>{"Output"});
+  REQUIRE(info.mutex_groups.size() == 1);
+  REQUIRE(info.mutex_groups[0].is_required);
+  REQUIRE(info.mutex_groups[0].arguments == std::vector<std::size_t>{1, 2});
+  REQUIRE(info.subcommands.size() == 1);
+  REQUIRE(info.subcommands[0].name == "run");
+  REQUIRE(info.subcommands[0].description == "runs it");
+  REQUIRE(info.subcommands[0].parser == &command);
+}
+
+TEST_CASE("Users can export a parser as JSON" * test_suite("doc_export")) {
+  argparse::ArgumentParser program("test", "2.0",
+                                   argparse::default_arguments::none);
+  program.add_description("says \"hi\"");
+  program.add_argument("-n").nargs(1, 3).help("a\tb");
+  program.add_argument("--hidden").hidden();
+
+  REQUIRE(argparse::export_docs(program, {argparse::doc_format::json}) ==
+          R"({"name":"test","path":"test","version":"2.0",)"
+          R"("description":"says \"hi\"","epilog":"",)"
+          R"("usage":"Usage: test [-n VAR...]","arguments":[)"
+          R"({"names":["-n"],"help":"a\tb","metavar":"",)"
+          R"("nargs":{"min":1,"max":3},"default":null,"choices":[],)"
+          R"("positional":false,"required":false,"repeatable":false,)"
+          R"("hidden":false,"group":null}],"groups":[],"mutex_groups":[],)"
+          R"("subcommands":[]})");
+}
+
+TEST_CASE("Users can export a tree of parsers" * test_suite("doc_export")) {
+  argparse::ArgumentParser program("git");
+  program.add_argument("-C").metavar("PATH").help("run as if started in PATH");
+  argparse::ArgumentParser remote("remote");
+  remote.add_description("Manage remotes");
+  argparse::ArgumentParser add("add");
+  add.add_argument("name");
+  remote.add_subparser(add);
+  argparse::ArgumentParser internal("internal");
+  internal.set_suppress(true);
+  program.add_subparser(remote);
+  program.add_subparser(internal);
+
+  SUBCASE("as Markdown") {
+    const auto docs = argparse::export_docs(program);
+    REQUIRE(contains(docs, "# git\n"));
+    REQUIRE(contains(docs, "- `-C PATH`: run as if started in PATH\n"));
+    REQUIRE(contains(docs, "## Subcommands\n\n- `remote`: Manage remotes\n"));
+    REQUIRE(contains(docs, "\n## git remote\n\nManage remotes\n"));
+    REQUIRE(contains(docs, "\n### remote add\n"));
+    REQUIRE_FALSE(contains(docs, "internal"));
+  }
+
+  SUBCASE("as a man page") {
+    const auto docs =
+        argparse::export_docs(program, {argparse::doc_format::man});
+    REQUIRE(docs.rfind(".TH \"GIT\" \"1\"", 0) == 0);
+    REQUIRE(contains(docs, ".TP\n\\fB\\-C PATH\\fR\n"));
+    REQUIRE(contains(docs, ".SH \"GIT REMOTE\"\n"));
+    REQUIRE_FALSE(contains(docs, "internal"));
+  }
+
+  SUBCASE("with hidden subcommands") {
+    argparse::DocOptions options;
+    options.format = argparse::doc_format::json;
+    options.include_hidden = true;
+    REQUIRE(contains(argparse::export_docs(program, options),
+                     R"("name":"internal")"));
+  }
+}
+
+TEST_CASE("Parsers are exported the same on several threads" *
+          test_suite("doc_export")) {
+  argparse::ArgumentParser program("tool");
+  std::list<argparse::ArgumentParser> commands;
+  for (int i = 0; i < 20; ++i) {
+    auto &command = commands.emplace_back("command" + std::to_string(i));
+    command.add_argument("--option").help("option " + std::to_string(i));
+    program.add_subparser(command);
+  }
+
+  for (const auto format : {argparse::doc_format::man,
+                            argparse::doc_format::markdown,
+                            argparse::doc_format::json}) {
+    argparse::DocOptions options;
+    options.format = format;
+    const auto serial = argparse::export_docs(program, options);
+    options.threads = 4;
+    REQUIRE(argparse::export_docs(program, options) == serial);
+  }
+}
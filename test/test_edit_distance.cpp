@@ -0,0 +1,129 @@
+#ifdef WITH_MODULE
+import argparse;
+import argparse.details;
+#else
+#include <argparse/argparse.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using doctest::test_suite;
+
+namespace {
+
+// The full dynamic programming matrix, as a reference
+std::size_t reference_distance(std::string_view s1, std::string_view s2) {
+  std::vector<std::vector<std::size_t>> dp(
+      s1.size() + 1, std::vector<std::size_t>(s2.size() + 1, 0));
+  for (std::size_t i = 0; i <= s1.size(); ++i) {
+    for (std::size_t j = 0; j <= s2.size(); ++j) {
+      if (i == 0 || j == 0) {
+        dp[i][j] = i + j;
+      } else {
+        dp[i][j] = std::min({dp[i - 1][j] + 1, dp[i][j - 1] + 1,
+                             dp[i - 1][j - 1] + (s1[i - 1] != s2[j - 1])});
+      }
+    }
+  }
+  return dp[s1.size()][s2.size()];
+}
+
+std::string random_string(std::mt19937 &random, std::size_t max_size) {
+  std::uniform_int_distribution<std::size_t> size(0, max_size);
+  std::uniform_int_distribution<int> letter('a', 'd');
+  std::string s(size(random), ' ');
+  for (auto &c : s) {
+    c = static_cast<char>(letter(random));
+  }
+  return s;
+}
+
+} // namespace
+
+TEST_CASE("Levenshtein distance" * test_suite("edit_distance")) {
+  using argparse::details::get_levenshtein_distance;
+  REQUIRE(get_levenshtein_distance("", "") == 0);
+  REQUIRE(get_levenshtein_distance("", "abc") == 3);
+  REQUIRE(get_levenshtein_distance("kitten", "sitting") == 3);
+  REQUIRE(get_levenshtein_distance("notes", "tote") == 2);
+  REQUIRE(get_levenshtein_distance("kitten", "sitting", 2) == 3);
+  REQUIRE(get_levenshtein_distance("kitten", "sitting", 3) == 3);
+
+  // Short strings use bit vectors, long ones a band of two rows
+  std::mt19937 random(7);
+  for (const std::size_t max_size : {8U, 70U, 150U}) {
+    for (int i = 0; i < 300; ++i) {
+      const auto s1 = random_string(random, max_size);
+      const auto s2 = random_string(random, max_size);
+      CAPTURE(s1);
+      CAPTURE(s2);
+      const auto expected = reference_distance(s1, s2);
+      REQUIRE(get_levenshtein_distance(s1, s2) == expected);
+      for (const std::size_t bound : {0U, 1U, 3U, 10U, 40U}) {
+        REQUIRE(get_levenshtein_distance(s1, s2, bound) ==
+                std::min<std::size_t>(expected, bound + 1));
+      }
+    }
+  }
+}
+
+TEST_CASE("Closest names within a distance" * test_suite("edit_distance")) {
+  const std::vector<std::string> names{"status", "stash",  "start",
+                                       "commit", "statuses", "stat"};
+  const auto closest = [&](std::string_view input, std::size_t max_distance,
+                           std::size_t count) {
+    return argparse::details::get_most_similar_strings(
+        names, [](const std::string &name) { return std::string_view(name); },
+        input, max_distance, count);
+  };
+
+  REQUIRE(closest("stats", 2, 3) ==
+          std::vector<std::string_view>{"status", "stat", "stash"});
+  REQUIRE(closest("stats", 1, 10) ==
+          std::vector<std::string_view>{"status", "stat"});
+  REQUIRE(closest("commit", 0, 2) == std::vector<std::string_view>{"commit"});
+  REQUIRE(closest("xyz", 2, 3).empty());
+  REQUIRE(closest("stats", 2, 0).empty());
+
+  const std::map<std::string, int> commands{{"add", 0}, {"log", 1}};
+  REQUIRE(argparse::details::get_most_similar_strings(
+              commands,
+              [](const auto &entry) { return std::string_view(entry.first); },
+              "lgo", 2, 1) == std::vector<std::string_view>{"log"});
+}
+
+TEST_CASE("SimilarityIndex finds the closest names" *
+          test_suite("edit_distance")) {
+  std::mt19937 random(11);
+  for (const std::size_t max_size : {6U, 80U}) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 200; ++i) {
+      names.push_back(random_string(random, max_size));
+    }
+    argparse::details::SimilarityIndex index;
+    index.assign(names);
+    REQUIRE(index.size() == names.size());
+
+    for (int i = 0; i < 100; ++i) {
+      const auto input = random_string(random, max_size);
+      CAPTURE(input);
+      for (const std::size_t max_distance : {0U, 1U, 2U, 5U, 100U}) {
+        for (const std::size_t count : {1U, 3U}) {
+          REQUIRE(index.find(input, max_distance, count) ==
+                  argparse::details::get_most_similar_strings(
+                      names,
+                      [](const std::string &name) {
+                        return std::string_view(name);
+                      },
+                      input, max_distance, count));
+        }
+      }
+    }
+  }
+}
@@ -6,6 +6,7 @@ import argparse;
 #include <doctest.hpp>
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -105,20 +106,43 @@ TEST_CASE("Detect unknown subcommand" * test_suite("error_reporting")) {
   program.add_subparser(add_command);
 
   SUBCASE("Typo for 'notes'") {
-    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "tote"}),
-                           "Failed to parse 'tote', did you mean 'notes'",
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "note"}),
+                           "Failed to parse 'note', did you mean 'notes'",
                            std::runtime_error);
   }
 
   SUBCASE("Typo for 'add'") {
-    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "bad"}),
-                           "Failed to parse 'bad', did you mean 'add'",
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "addd"}),
+                           "Failed to parse 'addd', did you mean 'add'",
                            std::runtime_error);
   }
 
   SUBCASE("Typo for 'log'") {
-    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "logic"}),
-                           "Failed to parse 'logic', did you mean 'log'",
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "logs"}),
+                           "Failed to parse 'logs', did you mean 'log'",
                            std::runtime_error);
   }
+
+  SUBCASE("No subcommand close enough") {
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"git", "tote"}),
+                           "Failed to parse 'tote'", std::runtime_error);
+  }
+}
+
+TEST_CASE("Suggest a subcommand among many" * test_suite("error_reporting")) {
+  argparse::ArgumentParser program("tool");
+  for (int i = 0; i < 2000; ++i) {
+    program.add_subparser("command" + std::to_string(i), std::string(), [i] {
+      return std::make_unique<argparse::ArgumentParser>("command" +
+                                                        std::to_string(i));
+    });
+  }
+  program.freeze();
+
+  REQUIRE_THROWS_WITH_AS(program.parse({"tool", "comand1999"}),
+                         "Failed to parse 'comand1999', did you mean "
+                         "'command1999'",
+                         std::runtime_error);
+  REQUIRE_THROWS_WITH_AS(program.parse({"tool", "frobnicate"}),
+                         "Failed to parse 'frobnicate'", std::runtime_error);
 }
\ No newline at end of file
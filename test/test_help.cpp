@@ -5,8 +5,14 @@ import argparse;
 #endif
 #include <doctest.hpp>
 
+#include <iterator>
+#include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 using doctest::test_suite;
 
@@ -202,6 +208,30 @@ TEST_CASE("multiline usage, several groups") {
         "               [-b]");
 }
 
+TEST_CASE("multiline usage, mutex in a group") {
+    argparse::ArgumentParser program("program");
+    program.set_usage_max_line_width(80);
+    program.add_argument("-a").flag();
+    program.add_group("Advanced options");
+    program.add_argument("-b").flag();
+    auto &group = program.add_mutually_exclusive_group();
+    group.add_argument("-c").flag();
+    group.add_argument("-d").flag();
+    program.add_group("Expert options");
+    auto &other_group = program.add_mutually_exclusive_group();
+    other_group.add_argument("-e").flag();
+    other_group.add_argument("-f").flag();
+    // std::cout << "DEBUG:" << program.usage() << std::endl;
+    REQUIRE(program.usage() ==
+        "Usage: program [--help] [--version] [-a]\n"
+        "\n"
+        "Advanced options:\n"
+        "               [-b] [[-c]|[-d]]\n"
+        "\n"
+        "Expert options:\n"
+        "               [[-e]|[-f]]");
+}
+
 TEST_CASE("multiline usage, no break on mutex") {
     argparse::ArgumentParser program("program");
     program.set_usage_max_line_width(80);
@@ -254,3 +284,104 @@ TEST_CASE("multiline usage, single arg that is larger than the max width") {
         "Usage: program [--help] [--version]\n"
         "               [--lots-of-choices <veeeeeeeeeeeeeeeeeeeeeeeeeeery_long|veeeeeeeeeeeeeeeeeeeery_long2>]");
 }
+
+TEST_CASE("Help is rendered again after the parser changes" *
+          test_suite("help")) {
+  argparse::ArgumentParser program("program");
+  argparse::ArgumentParser command("command");
+  program.add_argument("--foo").help("foo help");
+  const auto before = program.help().str();
+  REQUIRE(*program.help_text() == before);
+
+  SUBCASE("an argument is added") {
+    program.add_argument("--bar");
+    REQUIRE(program.help_text()->find("--bar") != std::string_view::npos);
+  }
+  SUBCASE("an argument is changed") {
+    program.at("--foo").help("other help");
+    REQUIRE(program.help_text()->find("other help") != std::string_view::npos);
+  }
+  SUBCASE("a subparser is changed") {
+    program.add_subparser(command);
+    REQUIRE(program.help_text()->find("Subcommands") != std::string_view::npos);
+    command.set_suppress(true);
+    REQUIRE(program.help_text()->find("Subcommands") == std::string_view::npos);
+  }
+  REQUIRE(*program.help_text() != before);
+  REQUIRE(*program.help_text() == program.help().str());
+}
+
+TEST_CASE("Users can format help into a buffer" * test_suite("help")) {
+  argparse::ArgumentParser program("program");
+  program.add_argument("input").help("positional input");
+
+  std::string help;
+  program.format_help(std::back_inserter(help));
+  REQUIRE(help == program.help().str());
+
+  char usage[64]{};
+  const auto *end = program.format_usage(usage);
+  REQUIRE(std::string_view(usage, static_cast<std::size_t>(end - usage)) ==
+          "Usage: program [--help] [--version] input");
+  REQUIRE(*program.usage_text() == program.usage());
+}
+
+TEST_CASE("Help is read while a subparser is built on another thread" *
+          test_suite("help")) {
+  argparse::ArgumentParser program("git");
+  program.add_subparser("add", "Add file contents to the index", [] {
+    auto parser = std::make_unique<argparse::ArgumentParser>("add");
+    parser->add_argument("files").remaining();
+    return parser;
+  });
+  program.freeze();
+  const auto help = program.help().str();
+  const auto held = program.help_text();
+
+  std::vector<std::string> copies(4);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < copies.size(); ++t) {
+    threads.emplace_back([&program, &copy = copies[t], t] {
+      for (int i = 0; i < 1000; ++i) {
+        copy.clear();
+        if (t % 2 == 0) {
+          program.format_help(std::back_inserter(copy));
+        } else {
+          const auto text = program.help_text();
+          copy.assign(text->begin(), text->end());
+        }
+      }
+    });
+  }
+  program.parse({"git", "add", "a.txt"});
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (const auto &copy : copies) {
+    REQUIRE(copy == help);
+  }
+  REQUIRE(*held == help);
+}
+
+TEST_CASE("Help text can be kept as views of static text" *
+          test_suite("help")) {
+  static constexpr const char *help = "a help text longer than a short string";
+  argparse::ArgumentParser owned("program");
+  owned.add_description("the description");
+  owned.add_epilog("the epilog");
+  owned.add_argument("-a").help(help).metavar("A_VALUE");
+  owned.add_group("A group");
+  owned.add_argument("-b").help("help of b");
+
+  argparse::ArgumentParser viewed("program");
+  viewed.add_description(argparse::StaticText("the description"));
+  viewed.add_epilog(argparse::StaticText("the epilog"));
+  viewed.add_argument("-a")
+      .help(argparse::StaticText(help))
+      .metavar(argparse::StaticText("A_VALUE"));
+  viewed.add_group(argparse::StaticText("A group"));
+  viewed.add_argument("-b").help(argparse::StaticText("help of b"));
+
+  REQUIRE(viewed.help().str() == owned.help().str());
+  REQUIRE(viewed.describe().arguments[2].help.data() == help);
+}
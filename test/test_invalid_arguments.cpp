@@ -5,6 +5,10 @@ import argparse;
 #endif
 #include <doctest.hpp>
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 using doctest::test_suite;
 
 TEST_CASE("Parse unknown optional argument" *
@@ -40,5 +44,44 @@ TEST_CASE("Parse unknown optional argument" *
       .help("memory in MB to give the VMM when loading");
 
   REQUIRE_THROWS_WITH_AS(bfm.parse_args({"./test.exe", "-om"}),
-                         "Unknown argument: -om", std::runtime_error);
+                         "Unknown argument: -om, did you mean '-m'",
+                         std::runtime_error);
+}
+
+TEST_CASE("Suggest the closest option for an unknown one" *
+          test_suite("compound_arguments")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--option").flag();
+  program.add_argument("--optional").flag();
+  program.add_argument("-o", "--output");
+  program.add_argument("--secret").flag().hidden();
+  auto &level = program.add_argument("--level");
+  program.add_hidden_alias_for(level, "--lvl");
+
+  const auto error_of = [&](std::vector<std::string> command_line) {
+    try {
+      program.parse(command_line);
+    } catch (const std::runtime_error &e) {
+      return std::string(e.what());
+    }
+    return std::string{};
+  };
+
+  // Built on the fly until the parser is frozen, then from the index
+  for (int frozen = 0; frozen < 2; ++frozen) {
+    CAPTURE(frozen);
+    REQUIRE(error_of({"test", "--optoin"}) ==
+            "Unknown argument: --optoin, did you mean '--option'");
+    REQUIRE(error_of({"test", "--optinal"}) ==
+            "Unknown argument: --optinal, did you mean '--optional'");
+    REQUIRE(error_of({"test", "--outptu", "x"}) ==
+            "Unknown argument: --outptu, did you mean '--output'");
+    REQUIRE(error_of({"test", "--levle", "1"}) ==
+            "Unknown argument: --levle, did you mean '--level'");
+    REQUIRE(error_of({"test", "--secert"}) == "Unknown argument: --secert");
+    REQUIRE(error_of({"test", "--lvx"}) == "Unknown argument: --lvx");
+    REQUIRE(error_of({"test", "--colour"}) == "Unknown argument: --colour");
+    REQUIRE(error_of({"test", "-x"}) == "Unknown argument: -x");
+    program.freeze();
+  }
 }
@@ -0,0 +1,107 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/argparse.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <string>
+#include <vector>
+
+using doctest::test_suite;
+
+#ifdef ARGPARSE_HAS_MEMORY_RESOURCE
+#include <memory_resource>
+
+namespace {
+
+// Counts the allocations made through it
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t allocations = 0;
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Construct a parser in a memory resource" *
+          test_suite("memory_resource")) {
+  CountingResource resource;
+  argparse::ArgumentParser program("test", "1.0",
+                                   argparse::default_arguments::all, true,
+                                   std::cout, &resource);
+  program.add_argument("--count").scan<'i', int>().default_value(1);
+  program.add_argument("files").remaining();
+  REQUIRE(resource.allocations > 0);
+
+  const auto before = resource.allocations;
+  program.parse_args({"test", "--count", "3", "a", "b"});
+  REQUIRE(resource.allocations > before);
+  REQUIRE(program.get<int>("--count") == 3);
+  REQUIRE(program.get<std::vector<std::string>>("files") ==
+          std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("Parse into a monotonic buffer" * test_suite("memory_resource")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--verbose").flag();
+  program.add_argument("name");
+
+  std::byte buffer[4096];
+  for (int i = 0; i < 3; ++i) {
+    std::pmr::monotonic_buffer_resource arena(
+        buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    const auto result = program.parse({"test", "--verbose", "x"}, &arena);
+    REQUIRE(result.get<bool>("--verbose"));
+    REQUIRE(result.get("name") == "x");
+  }
+  REQUIRE_FALSE(program.is_used("--verbose"));
+}
+
+TEST_CASE("Values are allocated outside the memory resource" *
+          test_suite("memory_resource")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--name");
+  program.add_argument("--sizes").scan<'i', int>().nargs(
+      argparse::nargs_pattern::any);
+
+  // Only the containers around the values come from the resource, so the
+  // length of a string or the number of typed values does not change it
+  const auto allocations = [&program](const std::vector<std::string> &args) {
+    CountingResource resource;
+    const auto result = program.parse(args, &resource);
+    return resource.allocations;
+  };
+  const std::string long_name(100, 'x');
+  REQUIRE(allocations({"test", "--name", "x", "--sizes", "1"}) ==
+          allocations({"test", "--name", long_name, "--sizes", "1", "2", "3",
+                       "4", "5", "6", "7", "8"}));
+}
+
+TEST_CASE("Subparsers share the allocator of a parse" *
+          test_suite("memory_resource")) {
+  argparse::ArgumentParser program("test");
+  argparse::ArgumentParser add("add");
+  add.add_argument("file");
+  program.add_subparser(add);
+
+  CountingResource resource;
+  const auto result = program.parse({"test", "add", "x"}, &resource);
+  REQUIRE(resource.allocations > 0);
+  REQUIRE(result.is_subcommand_used("add"));
+  REQUIRE(result.at("add").get("file") == "x");
+}
+
+#endif
@@ -232,3 +232,24 @@ TEST_CASE("Parse a vector of string arguments and construct objects" *
   REQUIRE(vector[3].m_value == Foo("jkl").m_value);
   REQUIRE(vector[4].m_value == Foo("mno").m_value);
 }
+
+TEST_CASE("Parse values that outlive argv" * test_suite("parse_args")) {
+  argparse::ArgumentParser program("test");
+  argparse::ArgumentParser run_command("run");
+  run_command.add_argument("--name");
+  run_command.add_argument("files").remaining();
+  program.add_subparser(run_command);
+
+  std::string args[] = {"test", "run", "--name=foo", "a.txt", "b.txt"};
+  const char *argv[] = {args[0].c_str(), args[1].c_str(), args[2].c_str(),
+                        args[3].c_str(), args[4].c_str()};
+  program.parse_args(5, argv);
+  for (auto &arg : args) {
+    std::fill(arg.begin(), arg.end(), 'x');
+  }
+
+  REQUIRE(program.is_subcommand_used("run"));
+  REQUIRE(run_command.get("--name") == "foo");
+  REQUIRE(run_command.get<std::vector<std::string>>("files") ==
+          std::vector<std::string>{"a.txt", "b.txt"});
+}
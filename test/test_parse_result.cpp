@@ -0,0 +1,123 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/argparse.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <string>
+#include <vector>
+
+using doctest::test_suite;
+
+TEST_CASE("Parse without changing the parser" * test_suite("ParseResult")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").scan<'i', int>().default_value(1);
+  program.add_argument("--name");
+  program.add_argument("files").remaining();
+
+  auto result = program.parse({"test", "--count", "3", "a", "b"});
+
+  REQUIRE(result.get<int>("--count") == 3);
+  REQUIRE(result.is_used("--count"));
+  REQUIRE_FALSE(result.is_used("--name"));
+  REQUIRE(result.present("--name") == std::nullopt);
+  REQUIRE(result.get<std::vector<std::string>>("files") ==
+          std::vector<std::string>{"a", "b"});
+  REQUIRE(result);
+
+  // the parser itself is left untouched
+  REQUIRE_FALSE(program);
+  REQUIRE_FALSE(program.is_used("--count"));
+  REQUIRE_THROWS_AS(program.get<int>("--count"), std::logic_error);
+}
+
+TEST_CASE("Results of parse() are independent" *
+          test_suite("ParseResult")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").scan<'i', int>().default_value(1);
+
+  auto first = program.parse({"test", "--count", "3"});
+  auto second = program.parse({"test"});
+  auto third = program.parse({"test", "--count", "7"});
+
+  REQUIRE(first.get<int>("--count") == 3);
+  REQUIRE(second.get<int>("--count") == 1);
+  REQUIRE_FALSE(second.is_used("--count"));
+  REQUIRE_FALSE(second);
+  REQUIRE(third.get<int>("--count") == 7);
+}
+
+TEST_CASE("Parse a subcommand with parse()" *
+          test_suite("ParseResult")) {
+  argparse::ArgumentParser program("git");
+
+  argparse::ArgumentParser add_command("add");
+  add_command.add_argument("files").remaining();
+  argparse::ArgumentParser commit_command("commit");
+  commit_command.add_argument("-m");
+
+  program.add_subparser(add_command);
+  program.add_subparser(commit_command);
+
+  auto result = program.parse({"git", "commit", "-m", "message"});
+
+  REQUIRE(result.is_subcommand_used("commit"));
+  REQUIRE_FALSE(result.is_subcommand_used("add"));
+  REQUIRE(result.at("commit").get("-m") == "message");
+  REQUIRE_THROWS_AS(result.at("add"), std::logic_error);
+
+  REQUIRE_FALSE(program.is_subcommand_used("commit"));
+  REQUIRE_FALSE(commit_command.is_used("-m"));
+}
+
+TEST_CASE("Validate the result of parse()" *
+          test_suite("ParseResult")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--input").required();
+  auto &group = program.add_mutually_exclusive_group();
+  group.add_argument("--first").flag();
+  group.add_argument("--second").flag();
+
+  REQUIRE_THROWS_WITH_AS(program.parse({"test"}), "--input: required.",
+                         std::runtime_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse({"test", "--input", "x", "--first", "--second"}),
+      "Argument '--second' not allowed with '--first'", std::runtime_error);
+  REQUIRE(program.parse({"test", "--input", "x", "--first"})
+              .get<bool>("--first"));
+}
+
+TEST_CASE("Parse known args with parse_known()" * test_suite("ParseResult")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--foo").implicit_value(true).default_value(false);
+
+  auto result = program.parse_known({"test", "--foo", "--bar", "baz"});
+
+  REQUIRE(result.get<bool>("--foo"));
+  REQUIRE(result.unknown_arguments() ==
+          std::vector<std::string>{"--bar", "baz"});
+}
+
+TEST_CASE("Parse with a frozen parser" * test_suite("ParseResult")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--first").flag();
+  program.add_argument("--second").default_value(std::string("x"));
+
+  argparse::ArgumentParser command("command");
+  command.add_argument("-v", "--verbose").flag();
+  program.add_subparser(command);
+
+  program.freeze();
+  auto result =
+      program.parse({"test", "--second=y", "--first", "command", "-v"});
+  REQUIRE(result.get<bool>("--first"));
+  REQUIRE(result.get("second") == "y");
+  REQUIRE(result.at("command").get<bool>("--verbose"));
+
+  // Arguments added after freeze() are still found
+  program.add_argument("--third").flag();
+  REQUIRE(program.parse({"test", "--third"}).get<bool>("--third"));
+  REQUIRE_THROWS_WITH_AS(program.parse({"test", "--fourth"}),
+                         "Unknown argument: --fourth", std::runtime_error);
+}
@@ -6,6 +6,9 @@ import argparse;
 #include <cmath>
 #include <doctest.hpp>
 
+#include <string>
+#include <vector>
+
 using doctest::test_suite;
 
 TEST_CASE("Parse with custom prefix chars" * test_suite("prefix_chars")) {
@@ -42,4 +45,19 @@ TEST_CASE("Parse with custom Windows-style prefix chars and assign chars" *
   REQUIRE(program.get("/A") == "D");
   REQUIRE(program.get("/B") == "Boo");
   REQUIRE(program.get<bool>("/C") == true);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tell values from options with custom prefix chars" *
+          test_suite("prefix_chars")) {
+  argparse::ArgumentParser program("test");
+  program.set_prefix_chars("-+");
+  program.add_argument("--values").nargs(argparse::nargs_pattern::any);
+  program.add_argument("+x").flag();
+  program.add_argument("-y").flag();
+  program.parse_args({"test", "--values", "-1", "+2", "-.5", "+1e3", "-",
+                      "+x", "-y"});
+  REQUIRE(program.get<std::vector<std::string>>("--values") ==
+          std::vector<std::string>{"-1", "+2", "-.5", "+1e3", "-"});
+  REQUIRE(program.get<bool>("+x"));
+  REQUIRE(program.get<bool>("-y"));
+}
@@ -4,6 +4,7 @@ import argparse;
 #include <argparse/argparse.hpp>
 #endif
 #include <doctest.hpp>
+#include <limits>
 #include <stdint.h>
 
 using doctest::test_suite;
@@ -252,6 +253,70 @@ TEST_CASE_TEMPLATE("Parse a binary argument" * test_suite("scan"), T, uint8_t,
   }
 }
 
+TEST_CASE("Report invalid integers and integers out of the range of a type" *
+          test_suite("scan")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--any").scan<'i', int16_t>();
+  program.add_argument("--dec").scan<'d', int16_t>();
+  program.add_argument("--hex").scan<'x', uint16_t>();
+  program.add_argument("--bin").scan<'b', uint8_t>();
+  program.add_argument("--unsigned").scan<'u', uint32_t>();
+
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "0x10000"}),
+      "Failed to parse '0x10000' as hexadecimal: '10000' not representable",
+      std::range_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "0b10000000000000000"}),
+      "Failed to parse '0b10000000000000000' as binary: "
+      "'10000000000000000' not representable",
+      std::range_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "0100000"}),
+      "Failed to parse '0100000' as octal: '0100000' not representable",
+      std::range_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "-32769"}),
+      "Failed to parse '-32769' as decimal integer: '-32769' not "
+      "representable",
+      std::range_error);
+  REQUIRE_THROWS_WITH_AS(program.parse_args({"test", "--dec", "32768"}),
+                         "'32768' not representable", std::range_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--hex", "10000"}),
+      "Failed to parse '10000' as hexadecimal: '10000' not representable",
+      std::range_error);
+  REQUIRE_THROWS_WITH_AS(program.parse_args({"test", "--bin", "0b100000000"}),
+                         "'100000000' not representable", std::range_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--unsigned", "4294967296"}),
+      "'4294967296' not representable", std::range_error);
+
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "0x1g"}),
+      "Failed to parse '0x1g' as hexadecimal: pattern '1g' does not match "
+      "to the end",
+      std::invalid_argument);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "1-"}),
+      "Failed to parse '1-' as decimal integer: pattern '1-' does not "
+      "match to the end",
+      std::invalid_argument);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--any", "a"}),
+      "Failed to parse 'a' as decimal integer: pattern 'a' not found",
+      std::invalid_argument);
+
+  program.parse_args({"test", "--any", "-32768", "--dec", "32767", "--hex",
+                      "0xffff", "--bin", "0b11111111", "--unsigned",
+                      "4294967295"});
+  REQUIRE(program.get<int16_t>("--any") == -32768);
+  REQUIRE(program.get<int16_t>("--dec") == 32767);
+  REQUIRE(program.get<uint16_t>("--hex") == 0xffff);
+  REQUIRE(program.get<uint8_t>("--bin") == 0xff);
+  REQUIRE(program.get<uint32_t>("--unsigned") == 4294967295);
+}
+
 #define FLOAT_G(t, literal)                                                    \
   ([] {                                                                        \
     if constexpr (std::is_same_v<t, float>)                                    \
@@ -427,6 +492,62 @@ TEST_CASE_TEMPLATE("Parse floating-point argument of fixed format" *
   }
 }
 
+TEST_CASE_TEMPLATE("Floating-point arguments are read like strtod reads them" *
+                       test_suite("scan"),
+                   T, float, double, long double) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("-g").scan<'g', T>();
+  program.add_argument("-a").scan<'a', T>();
+
+  SUBCASE("infinity") {
+    program.parse_args({"test", "-g", "inf", "-a", "0x1p-2"});
+    REQUIRE(program.get<T>("-g") == std::numeric_limits<T>::infinity());
+    REQUIRE(program.get<T>("-a") == T(0.25));
+  }
+
+  SUBCASE("NaN") {
+    program.parse_args({"test", "-g", "NaN"});
+    REQUIRE(program.get<T>("-g") != program.get<T>("-g"));
+  }
+
+  SUBCASE("out of range") {
+    REQUIRE_THROWS_WITH_AS(
+        program.parse_args({"test", "-g", "1e999999"}),
+        "Failed to parse '1e999999' as number: '1e999999' not representable",
+        std::range_error);
+  }
+
+  SUBCASE("sign after the 0x prefix") {
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"test", "-a", "0x-1p0"}),
+                           "Failed to parse '0x-1p0' as hexadecimal: pattern "
+                           "'0x-1p0' does not match to the end",
+                           std::invalid_argument);
+  }
+
+  SUBCASE("trailing characters") {
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"test", "-g", "1.5e"}),
+                           "Failed to parse '1.5e' as number: pattern '1.5e' "
+                           "does not match to the end",
+                           std::invalid_argument);
+  }
+
+  SUBCASE("no number") {
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"test", "-g", "abc"}),
+                           "Failed to parse 'abc' as number: pattern 'abc' "
+                           "does not match to the end",
+                           std::invalid_argument);
+    REQUIRE_THROWS_WITH_AS(program.parse_args({"test", "-g", "+1"}),
+                           "Failed to parse '+1' as number: pattern '+1' "
+                           "not found",
+                           std::invalid_argument);
+  }
+
+  SUBCASE("empty") {
+    program.parse_args({"test", "-g", ""});
+    REQUIRE(program.get<T>("-g") == T(0));
+  }
+}
+
 TEST_CASE("Test that scan also works with a custom action" *
           test_suite("scan")) {
 
@@ -0,0 +1,144 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/static_parser.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using doctest::test_suite;
+
+namespace {
+
+constexpr argparse::StaticSchema schema{
+    argparse::StaticArgument<int, 'i'>("-n", "--count").default_value(1),
+    argparse::StaticArgument<bool>("-v", "--verbose").flag(),
+    argparse::StaticArgument<bool>("-q").flag(),
+    argparse::StaticArgument<unsigned, 'x'>("--mask"),
+    argparse::StaticArgument<double>("--range").nargs(2),
+    argparse::StaticArgument<std::string_view>("--name").required(),
+    argparse::StaticArgument<std::string_view>("input"),
+    argparse::StaticArgument<int, 'i'>("extra").nargs(0, 2)};
+
+using Parser = argparse::StaticParser<schema>;
+
+// An ArgumentParser with the same arguments as schema
+void add_arguments(argparse::ArgumentParser &program) {
+  program.add_argument("-n", "--count").scan<'i', int>().default_value(1);
+  program.add_argument("-v", "--verbose").flag();
+  program.add_argument("-q").flag();
+  program.add_argument("--mask").scan<'x', unsigned>();
+  program.add_argument("--range").nargs(2).type<double>();
+  program.add_argument("--name").required();
+  program.add_argument("input");
+  program.add_argument("extra").nargs(0, 2).scan<'i', int>();
+}
+
+} // namespace
+
+TEST_CASE("Parse with a StaticParser" * test_suite("static_parser")) {
+  auto result = Parser::parse_args({"test", "-vn", "3", "--mask", "0xff",
+                                    "--range=0.5", "2", "--name", "x", "in",
+                                    "4", "-5"});
+
+  REQUIRE(result.get<schema.index("--count")>() == 3);
+  REQUIRE(result.get<schema.index("verbose")>());
+  REQUIRE_FALSE(result.get<schema.index("q")>());
+  REQUIRE(result.get<schema.index("mask")>() == 0xffU);
+  const auto &range = result.get<schema.index("--range")>();
+  REQUIRE(std::vector<double>(range.begin(), range.end()) ==
+          std::vector<double>{0.5, 2.0});
+  REQUIRE(result.get<schema.index("--name")>() == "x");
+  REQUIRE(result.get<schema.index("input")>() == "in");
+  const auto &extra = result.get<schema.index("extra")>();
+  REQUIRE(std::vector<int>(extra.begin(), extra.end()) ==
+          std::vector<int>{4, -5});
+  REQUIRE(result.is_used<schema.index("-v")>());
+  REQUIRE_FALSE(result.is_used<schema.index("-q")>());
+  REQUIRE(result);
+}
+
+TEST_CASE("Default and missing values of a StaticParser" *
+          test_suite("static_parser")) {
+  auto result = Parser::parse_args({"test", "--name", "x", "in"});
+
+  REQUIRE(result.get<schema.index("--count")>() == 1);
+  REQUIRE_FALSE(result.get<schema.index("--verbose")>());
+  REQUIRE(result.present<schema.index("--mask")>() == std::nullopt);
+  REQUIRE_THROWS_WITH_AS(result.get<schema.index("--mask")>(),
+                         "No value provided for '--mask'.", std::logic_error);
+  REQUIRE(result.get<schema.index("extra")>().empty());
+}
+
+TEST_CASE("Look up StaticSchema arguments" * test_suite("static_parser")) {
+  static_assert(schema.index("-n") == 0);
+  static_assert(schema.index("--count") == 0);
+  static_assert(schema.index("count") == 0);
+  static_assert(schema.index("n") == 0);
+  static_assert(schema.index("input") == 6);
+  REQUIRE_THROWS_WITH_AS(schema.index("--input"),
+                         "No such argument: --input", std::logic_error);
+}
+
+TEST_CASE("StaticParser accepts the command lines of an ArgumentParser" *
+          test_suite("static_parser")) {
+  argparse::ArgumentParser program("test", "1.0",
+                                   argparse::default_arguments::none);
+  add_arguments(program);
+
+  const std::vector<std::vector<std::string>> command_lines{
+      {"test", "--name", "x", "in"},
+      {"test", "-qv", "--name=x", "in", "1"},
+      {"test", "--name", "x", "--count", "-2", "in"},
+      {"test", "in", "--name", "x", "--range", "1", "1e3"},
+      {"test", "--name", "x"},
+      {"test", "in"},
+      {"test", "--name", "x", "in", "1", "2", "3"},
+      {"test", "--name", "x", "in", "--range", "1"},
+      {"test", "--name", "x", "in", "--range", "1", "-v"},
+      {"test", "--name", "x", "in", "-qz"},
+      {"test", "--name", "x", "in", "--unknown"},
+      {"test", "--name", "x", "in", "--mkas", "1"},
+      {"test", "--name", "x", "in", "-v", "-v"},
+      {"test", "--name", "x", "in", "--count", "y"},
+      {"test", "--name", "x", "in", "--mask", "12"},
+      {"test", "--name"},
+  };
+
+  for (const auto &command_line : command_lines) {
+    CAPTURE(command_line.size());
+    std::optional<argparse::ParseResult> expected;
+    std::optional<Parser::Result> result;
+    std::string runtime_error;
+    std::string static_error;
+    try {
+      expected.emplace(program.parse(command_line));
+    } catch (const std::exception &e) {
+      runtime_error = e.what();
+    }
+    try {
+      result.emplace(Parser::parse_args(command_line));
+    } catch (const std::exception &e) {
+      static_error = e.what();
+    }
+    REQUIRE(static_error == runtime_error);
+    if (!expected) {
+      continue;
+    }
+    REQUIRE(result->get<schema.index("--count")>() ==
+            expected->get<int>("--count"));
+    REQUIRE(result->get<schema.index("--verbose")>() ==
+            expected->get<bool>("--verbose"));
+    REQUIRE(result->get<schema.index("-q")>() == expected->get<bool>("-q"));
+    REQUIRE(result->get<schema.index("--name")>() ==
+            expected->get("--name"));
+    REQUIRE(result->get<schema.index("input")>() == expected->get("input"));
+    const auto &extra = result->get<schema.index("extra")>();
+    REQUIRE(std::vector<int>(extra.begin(), extra.end()) ==
+            expected->get<std::vector<int>>("extra"));
+  }
+}
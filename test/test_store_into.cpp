@@ -4,6 +4,9 @@ import argparse;
 #include <argparse/argparse.hpp>
 #endif
 #include <cstdint>
+#include <deque>
+#include <list>
+#include <set>
 #include <doctest.hpp>
 
 using doctest::test_suite;
@@ -353,3 +356,75 @@ TEST_CASE("Test store_into(int) still works with a custom action" *
   }
 }
 
+
+TEST_CASE("Test store_into(list of double), multi valued, specified" *
+          test_suite("store_into")) {
+  argparse::ArgumentParser program("test");
+  std::list<double> res;
+  program.add_argument("--doublelist-opt").nargs(3).store_into(res);
+
+  program.parse_args({"./test.exe", "--doublelist-opt", "1.5", "-2", "3e2"});
+  REQUIRE(res == std::list<double>{1.5, -2.0, 300.0});
+}
+
+TEST_CASE("Test store_into(set of unsigned), repeated, specified" *
+          test_suite("store_into")) {
+  argparse::ArgumentParser program("test");
+  std::set<unsigned> res{42};
+  program.add_argument("--uintset-opt").append().store_into(res);
+
+  program.parse_args(
+      {"./test.exe", "--uintset-opt", "3", "--uintset-opt", "1"});
+  REQUIRE(res == std::set<unsigned>{1, 3});
+}
+
+TEST_CASE("Test store_into(deque of string), positional, many values" *
+          test_suite("store_into")) {
+  argparse::ArgumentParser program("test");
+  std::deque<std::string> res;
+  program.add_argument("files").remaining().store_into(res);
+
+  std::vector<std::string> args{"./test.exe"};
+  for (int i = 0; i < 10000; ++i) {
+    args.push_back(std::to_string(i));
+  }
+  program.parse_args(args);
+  REQUIRE(res.size() == 10000);
+  REQUIRE(res.front() == "0");
+  REQUIRE(res.back() == "9999");
+}
+
+TEST_CASE("Test store_into(vector of int) with an invalid value" *
+          test_suite("store_into")) {
+  argparse::ArgumentParser program("test");
+  std::vector<int> res;
+  program.add_argument("--intvector-opt").nargs(2).store_into(res);
+
+  REQUIRE_THROWS_AS(
+      program.parse_args({"./test.exe", "--intvector-opt", "1", "x"}),
+      std::invalid_argument);
+}
+
+TEST_CASE("Test store_into(vector of int), parsed twice by parse()" *
+          test_suite("store_into")) {
+  argparse::ArgumentParser program("test");
+  std::vector<int> res;
+  program.add_argument("--intvector-opt").append().store_into(res);
+
+  program.parse({"./test.exe", "--intvector-opt", "1"});
+  program.parse({"./test.exe", "--intvector-opt", "2", "--intvector-opt",
+                     "3"});
+  REQUIRE(res == std::vector<int>{2, 3});
+}
+
+TEST_CASE("Test store_into(vector of string) twice on one argument" *
+          test_suite("store_into")) {
+  argparse::ArgumentParser program("test");
+  std::vector<std::string> first{"old"};
+  std::set<int> second{7};
+  program.add_argument("--y").append().store_into(first).store_into(second);
+
+  program.parse_args({"./test.exe", "--y", "1", "--y", "2"});
+  REQUIRE(first == std::vector<std::string>{"1", "2"});
+  REQUIRE(second == std::set<int>{1, 2});
+}
@@ -6,6 +6,7 @@ import argparse;
 #include <doctest.hpp>
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -306,3 +307,63 @@ TEST_CASE("Help of subparsers" * test_suite("subparsers")) {
                           "  -v, --version  prints version information and exits \n"
                           "  --help         \n");
 }
+
+TEST_CASE("Subparsers built on first use" * test_suite("subparsers")) {
+  argparse::ArgumentParser program("git");
+  int built = 0;
+  auto factory = [&built](const char *name) {
+    return [&built, name] {
+      ++built;
+      auto parser = std::make_unique<argparse::ArgumentParser>(name);
+      parser->add_description(std::string("built ") + name);
+      parser->add_argument("files").remaining();
+      return parser;
+    };
+  };
+  program.add_subparser("add", "Add file contents to the index",
+                        factory("add"));
+  program.add_subparser("commit",
+                        argparse::StaticText("Record changes to the repository"),
+                        factory("commit"));
+
+  SUBCASE("help lists registered descriptions without building") {
+    const auto help = program.help().str();
+    REQUIRE(contains(help, "  add           Add file contents to the index\n"));
+    REQUIRE(contains(help, "  commit        Record changes to the repository\n"));
+    REQUIRE(program.usage() == "Usage: git [--help] [--version] {add,commit}");
+    REQUIRE(built == 0);
+  }
+
+  SUBCASE("parsing builds only the dispatched subparser") {
+    program.parse_args({"git", "add", "a.txt", "b.txt"});
+    REQUIRE(built == 1);
+    REQUIRE(program.is_subcommand_used("add"));
+    REQUIRE_FALSE(program.is_subcommand_used("commit"));
+    auto &add = program.at<argparse::ArgumentParser>("add");
+    REQUIRE(add.get<std::vector<std::string>>("files") ==
+            std::vector<std::string>{"a.txt", "b.txt"});
+    REQUIRE(add.usage() == "Usage: git add [--help] [--version] [files]...");
+    REQUIRE(built == 1);
+  }
+
+  SUBCASE("describe builds the subparsers it documents") {
+    const auto info = program.describe();
+    REQUIRE(built == 2);
+    REQUIRE(info.subcommands.size() == 2);
+    REQUIRE(info.subcommands[1].name == "commit");
+    REQUIRE(info.subcommands[1].description ==
+            "Record changes to the repository");
+    REQUIRE(info.subcommands[1].parser->describe().description ==
+            "built commit");
+  }
+
+  SUBCASE("a factory must build the registered command") {
+    program.add_subparser("push", "Update remote refs", [] {
+      return std::make_unique<argparse::ArgumentParser>("pull");
+    });
+    REQUIRE_THROWS_WITH_AS(
+        program.parse_args({"git", "push"}),
+        "Subparser factory of push returned a parser named pull",
+        std::logic_error);
+  }
+}
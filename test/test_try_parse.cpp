@@ -0,0 +1,213 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/argparse.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using doctest::test_suite;
+
+namespace {
+
+// The what() of the exception parse() throws for the command line
+std::string error_of(const argparse::ArgumentParser &program,
+                     const std::vector<std::string> &command_line) {
+  try {
+    program.parse(command_line);
+  } catch (const std::exception &e) {
+    return e.what();
+  }
+  return {};
+}
+
+void add_arguments(argparse::ArgumentParser &program) {
+  program.add_argument("--count").scan<'i', int>();
+  program.add_argument("--ratio").scan<'g', double>();
+  program.add_argument("--mode").choices("fast", "slow");
+  program.add_argument("--pair").nargs(2);
+  program.add_argument("--name").required();
+  program.add_argument("--check").action([](const std::string &value) {
+    if (value == "bad") {
+      throw std::invalid_argument("Bad value for --check");
+    }
+  });
+  program.add_argument("--number").action(
+      [](const std::string &value) { return std::stoi(value); });
+  program.add_argument("input");
+}
+
+} // namespace
+
+TEST_CASE("try_parse returns the parsed values" *
+          test_suite("try_parse")) {
+  argparse::ArgumentParser program("test");
+  add_arguments(program);
+
+  auto result =
+      program.try_parse({"test", "--name", "x", "--count", "3", "in"});
+  REQUIRE(result);
+  REQUIRE(result->get<int>("--count") == 3);
+  REQUIRE(result->get("input") == "in");
+}
+
+TEST_CASE("try_parse reports errors without throwing" *
+          test_suite("try_parse")) {
+  using argparse::parse_errc;
+  argparse::ArgumentParser program("test");
+  add_arguments(program);
+  constexpr auto npos = argparse::ParseError::npos;
+
+  struct Case {
+    std::vector<std::string> command_line;
+    parse_errc code;
+    std::size_t token_index;
+    const char *argument;
+  };
+  const std::vector<Case> cases{
+      {{"test", "--name", "x", "in", "--bogus"},
+       parse_errc::unknown_argument, 4, nullptr},
+      {{"test", "--name", "x", "in", "extra"},
+       parse_errc::too_many_positionals, 4, nullptr},
+      {{"test", "--name", "x", "--name", "y", "in"},
+       parse_errc::duplicate_argument, 3, "--name"},
+      {{"test", "--name=x", "--name=y", "in"},
+       parse_errc::duplicate_argument, 2, "--name"},
+      {{"test", "--name", "x", "in", "--count", "12a"},
+       parse_errc::invalid_value, 5, "--count"},
+      {{"test", "--name", "x", "in", "--count", "99999999999"},
+       parse_errc::value_out_of_range, 5, "--count"},
+      {{"test", "--name", "x", "in", "--ratio", "1e999"},
+       parse_errc::value_out_of_range, 5, "--ratio"},
+      {{"test", "--name", "x", "in", "--mode", "medium"},
+       parse_errc::invalid_choice, 5, "--mode"},
+      {{"test", "--name", "x", "in", "--pair", "a"},
+       parse_errc::too_few_values, 4, "--pair"},
+      {{"test", "--name", "x", "in", "--check", "bad"},
+       parse_errc::invalid_value, 5, "--check"},
+      {{"test", "--name", "x", "in", "--number", "x"},
+       parse_errc::invalid_value, 5, "--number"},
+      {{"test", "in"}, parse_errc::required_argument, npos, "--name"},
+      {{"test", "--name", "x"}, parse_errc::wrong_number_of_values, npos,
+       "input"},
+  };
+
+  for (const auto &c : cases) {
+    CAPTURE(c.command_line.back());
+    auto result = program.try_parse(c.command_line);
+    REQUIRE_FALSE(result);
+    const auto &error = result.error();
+    REQUIRE(error.code() == c.code);
+    REQUIRE(error.token_index() == c.token_index);
+    if (c.token_index != npos) {
+      REQUIRE(c.command_line[c.token_index].find(error.token()) !=
+              std::string::npos);
+    }
+    if (c.argument != nullptr) {
+      REQUIRE(error.argument() == &program[c.argument]);
+    } else {
+      REQUIRE(error.argument() == nullptr);
+    }
+    REQUIRE(error.message() == error_of(program, c.command_line));
+  }
+}
+
+TEST_CASE("try_parse reports errors of groups and subcommands" *
+          test_suite("try_parse")) {
+  using argparse::parse_errc;
+  argparse::ArgumentParser program("test");
+  auto &group = program.add_mutually_exclusive_group(true);
+  group.add_argument("--first").flag();
+  group.add_argument("--second").flag();
+  argparse::ArgumentParser add("add");
+  add.add_argument("file");
+  program.add_subparser(add);
+
+  SUBCASE("mutually exclusive arguments") {
+    const std::vector<std::string> command_line{"test", "--first",
+                                                "--second"};
+    auto result = program.try_parse(command_line);
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error().code() == parse_errc::mutually_exclusive);
+    REQUIRE(result.error().argument() == &program["--second"]);
+    REQUIRE(result.error().message() == error_of(program, command_line));
+  }
+
+  SUBCASE("required group") {
+    const std::vector<std::string> command_line{"test"};
+    auto result = program.try_parse(command_line);
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error().code() == parse_errc::required_group);
+    REQUIRE(result.error().message() == error_of(program, command_line));
+  }
+
+  SUBCASE("unknown subcommand") {
+    const std::vector<std::string> command_line{"test", "--first", "adds"};
+    auto result = program.try_parse(command_line);
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error().code() == parse_errc::unknown_subcommand);
+    REQUIRE(result.error().token_index() == 2);
+    REQUIRE(result.error().message() ==
+            "Failed to parse 'adds', did you mean 'add'");
+  }
+
+  SUBCASE("error in a subcommand") {
+    const std::vector<std::string> command_line{"test", "--first", "add", "a",
+                                                "b"};
+    auto result = program.try_parse(command_line);
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error().code() == parse_errc::too_many_positionals);
+    REQUIRE(result.error().token_index() == 4);
+    REQUIRE(result.error().message() == error_of(program, command_line));
+  }
+}
+
+TEST_CASE("try_parse with argc and argv" * test_suite("try_parse")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").scan<'d', int>();
+
+  const char *argv[] = {"test", "--count", "x"};
+  auto result = program.try_parse(3, argv);
+  REQUIRE_FALSE(result);
+  REQUIRE(result.error().code() == argparse::parse_errc::invalid_value);
+  REQUIRE(result.error().token_index() == 2);
+  REQUIRE(result.error().token() == "x");
+}
+
+TEST_CASE("try_get reports the errors of get" * test_suite("try_parse")) {
+  using argparse::parse_errc;
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").scan<'i', int>();
+  program.add_argument("--ratio").scan<'g', double>();
+  program.add_argument("--names").nargs(argparse::nargs_pattern::any);
+
+  auto result = program.try_parse({"test", "--count", "2", "--names", "a"});
+  REQUIRE(result);
+
+  auto count = result->try_get<int>("count");
+  REQUIRE(count);
+  REQUIRE(*count == 2);
+  auto names = result->try_get<std::vector<std::string>>("--names");
+  REQUIRE(names);
+  REQUIRE(*names == std::vector<std::string>{"a"});
+
+  auto wrong_type = result->try_get<long>("--count");
+  REQUIRE_FALSE(wrong_type);
+  REQUIRE(wrong_type.error().code() == parse_errc::wrong_type);
+  REQUIRE_THROWS_AS(result->get<long>("--count"), std::bad_any_cast);
+
+  auto no_value = result->try_get<double>("--ratio");
+  REQUIRE_FALSE(no_value);
+  REQUIRE(no_value.error().code() == parse_errc::no_value);
+  REQUIRE(no_value.error().message() == "No value provided for '--ratio'.");
+
+  auto no_argument = result->try_get<int>("--size");
+  REQUIRE_FALSE(no_argument);
+  REQUIRE(no_argument.error().code() == parse_errc::no_such_argument);
+  REQUIRE(no_argument.error().argument() == nullptr);
+  REQUIRE(no_argument.error().token() == "--size");
+  REQUIRE(no_argument.error().message() == "No such argument: --size");
+}
@@ -0,0 +1,151 @@
+#ifdef WITH_MODULE
+import argparse;
+#else
+#include <argparse/argparse.hpp>
+#endif
+#include <doctest.hpp>
+
+#include <list>
+#include <string>
+#include <vector>
+
+using doctest::test_suite;
+
+TEST_CASE("Read scanned values without copies" * test_suite("typed_storage")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--sizes")
+      .nargs(argparse::nargs_pattern::at_least_one)
+      .scan<'u', unsigned>();
+
+  program.parse_args({"test", "--sizes", "1", "2", "3"});
+  const auto &sizes = program.get_view<unsigned>("--sizes");
+  REQUIRE(sizes == std::vector<unsigned>{1, 2, 3});
+  REQUIRE(&sizes == &program.get_view<unsigned>("--sizes"));
+  REQUIRE(program.get<std::vector<unsigned>>("--sizes") == sizes);
+  REQUIRE(program.get<std::list<unsigned>>("--sizes") ==
+          std::list<unsigned>{1, 2, 3});
+  REQUIRE(program.get<unsigned>("--sizes") == 1);
+}
+
+TEST_CASE("Store values with type<T>()" * test_suite("typed_storage")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").type<int>().default_value(5);
+  program.add_argument("--ratio").type<double>();
+  program.add_argument("--names").type<std::string>().append();
+
+  SUBCASE("with values") {
+    program.parse_args({"test", "--count", "-3", "--ratio", "0.5", "--names",
+                        "a", "--names", "b"});
+    REQUIRE(program.get<int>("--count") == -3);
+    REQUIRE(program.get<double>("--ratio") == doctest::Approx(0.5));
+    REQUIRE(program.get_view<std::string>("--names") ==
+            std::vector<std::string>{"a", "b"});
+    REQUIRE(program.present<double>("--ratio") == 0.5);
+  }
+
+  SUBCASE("without values") {
+    program.parse_args({"test"});
+    REQUIRE(program.get<int>("--count") == 5);
+    REQUIRE(program.present<double>("--ratio") == std::nullopt);
+    REQUIRE(program.get_view<int>("--count").empty());
+  }
+
+  SUBCASE("with an invalid value") {
+    REQUIRE_THROWS_AS(program.parse_args({"test", "--count", "x"}),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("get_view falls back to a vector default value" *
+          test_suite("typed_storage")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--ids")
+      .nargs(argparse::nargs_pattern::any)
+      .type<int>()
+      .default_value(std::vector<int>{7, 8});
+
+  program.parse_args({"test"});
+  REQUIRE(program.get_view<int>("--ids") == std::vector<int>{7, 8});
+}
+
+TEST_CASE("get_view checks the stored type" * test_suite("typed_storage")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--count").scan<'i', int>();
+  program.add_argument("--name");
+
+  program.parse_args({"test", "--count", "1", "--name", "x"});
+  REQUIRE_THROWS_AS(program.get_view<long>("--count"), std::bad_any_cast);
+  REQUIRE_THROWS_AS(program.get<long>("--count"), std::bad_any_cast);
+  REQUIRE_THROWS_AS(program.get_view<std::string>("--name"),
+                    std::logic_error);
+}
+
+TEST_CASE("Typed values in a ParseResult and through a handle" *
+          test_suite("typed_storage")) {
+  argparse::ArgumentParser program("test");
+  auto values = program.add_argument("values")
+                    .nargs(2)
+                    .scan<'g', float>()
+                    .handle<float>();
+
+  auto result = program.parse({"test", "1.5", "2.5"});
+  REQUIRE(result.get_view<float>("values") == std::vector<float>{1.5F, 2.5F});
+  REQUIRE(values.get_view(result) == std::vector<float>{1.5F, 2.5F});
+  REQUIRE(values.get(result) == 1.5F);
+  REQUIRE_FALSE(values.is_used());
+
+  program.parse_args({"test", "3", "4"});
+  REQUIRE(values.get_view() == std::vector<float>{3.0F, 4.0F});
+}
+
+TEST_CASE("Convert many decimal values at once" * test_suite("typed_storage")) {
+  std::vector<long long> stored;
+  argparse::ArgumentParser program("test");
+  program.add_argument("--ints")
+      .nargs(argparse::nargs_pattern::any)
+      .scan<'i', int>();
+  program.add_argument("--shorts")
+      .nargs(argparse::nargs_pattern::any)
+      .scan<'d', short>();
+  program.add_argument("--stored")
+      .nargs(argparse::nargs_pattern::any)
+      .store_into(stored);
+
+  std::vector<std::string> command_line{"test", "--ints"};
+  std::vector<int> ints;
+  for (int i = -3000; i <= 3000; i += 7) {
+    ints.push_back(i * 104729);
+    command_line.push_back(std::to_string(ints.back()));
+  }
+  // Values for the converter of each argument, after plain decimal values
+  command_line.insert(command_line.end(),
+                      {"0x1F", "010", "-2147483648", "2147483647", "0"});
+  ints.insert(ints.end(), {0x1F, 010, -2147483647 - 1, 2147483647, 0});
+  command_line.insert(command_line.end(),
+                      {"--shorts", "-32768", "00032767", "12", "-0"});
+  command_line.insert(command_line.end(),
+                      {"--stored", "123456789012345678", "-9", "007"});
+
+  program.parse_args(command_line);
+  REQUIRE(program.get_view<int>("--ints") == ints);
+  REQUIRE(program.get_view<short>("--shorts") ==
+          std::vector<short>{-32768, 32767, 12, 0});
+  REQUIRE(stored == std::vector<long long>{123456789012345678, -9, 7});
+}
+
+TEST_CASE("Report the first invalid value of many" *
+          test_suite("typed_storage")) {
+  argparse::ArgumentParser program("test");
+  program.add_argument("--ids")
+      .nargs(argparse::nargs_pattern::any)
+      .scan<'d', int>();
+
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--ids", "1", "2", "2147483648", "x"}),
+      "'2147483648' not representable",
+      std::range_error);
+  REQUIRE_THROWS_WITH_AS(
+      program.parse_args({"test", "--ids", "1", "12a", "x"}),
+      "pattern '12a' does not match to the end",
+      std::invalid_argument);
+}
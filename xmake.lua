@@ -5,6 +5,7 @@ set_version("3.2.0", { build = "%Y%m%d%H%M" })
 
 option("enable_module")
 option("enable_std_import", { defines = "ARGPARSE_MODULE_USE_STD_MODULE" })
+option("enable_lib")
 option("enable_tests")
 option("enable_samples")
 
@@ -35,11 +36,25 @@ target("argparse", function()
 
     add_includedirs("include", { public = true })
     add_headerfiles("include/argparse/argparse.hpp")
+    add_headerfiles("include/argparse/static_parser.hpp")
+    add_headerfiles("include/argparse/doc_export.hpp")
     if get_config("enable_module") then
         add_files("module/argparse.cppm", { install = true })
     end
 end)
 
+if get_config("enable_lib") then
+    target("argparse_lib", function()
+        set_kind("static")
+        set_languages("c++17")
+
+        add_files("src/argparse.cpp")
+        add_defines("ARGPARSE_COMPILED_LIB", { public = true })
+
+        add_deps("argparse")
+    end)
+end
+
 if get_config("enable_tests") then
     target("argparse_tests", function()
         set_kind("binary")
@@ -50,6 +65,9 @@ if get_config("enable_tests") then
 
         add_files("test/main.cpp", { defines = { "DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN" } })
         add_files("test/**.cpp")
+        if is_plat("linux") then
+            add_syslinks("pthread")
+        end
 
         add_deps("argparse")
     end)
@@ -66,6 +84,9 @@ if get_config("enable_tests") then
 
             add_files("test/main.cpp", { defines = { "DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN" } })
             add_files("test/**.cpp")
+        if is_plat("linux") then
+            add_syslinks("pthread")
+        end
             add_files("test/argparse_details.cppm")
 
             add_deps("argparse")